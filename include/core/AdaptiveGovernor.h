@@ -0,0 +1,64 @@
+#ifndef ADAPTIVEGOVERNOR_H
+#define ADAPTIVEGOVERNOR_H
+
+#include <QObject>
+#include "ColorDetection.h"
+
+// Holds the pipeline inside a per-frame latency budget. Frame costs are
+// averaged over short windows; when the average exceeds the budget detection
+// quality is stepped down, and when it exceeds the frame period the capture
+// cadence is lowered so the timer never backs up. Headroom steps both back up.
+class AdaptiveGovernor : public QObject {
+    Q_OBJECT
+
+public:
+    explicit AdaptiveGovernor(QObject* parent = nullptr);
+    ~AdaptiveGovernor();
+
+    // Settings
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void setLatencyBudget(double budgetMs);
+    double getLatencyBudget() const;
+
+    void setFPSRange(int minFPS, int maxFPS);
+    int getMinFPS() const;
+    int getMaxFPS() const;
+
+    void setEvaluationWindow(int frames);
+    int getEvaluationWindow() const;
+
+    // Feed the measured cost of one frame; returns true if a decision changed
+    bool recordFrameCost(double costMs);
+    void reset();
+
+    // Current decisions
+    int getCurrentFPS() const;
+    DetectionQuality getQuality() const;
+    double getAverageCost() const;
+    int getAdjustmentCount() const;
+
+signals:
+    void fpsAdjusted(int fps);
+    void qualityAdjusted(DetectionQuality quality);
+
+private:
+    bool m_enabled;
+    double m_latencyBudget;
+    int m_minFPS;
+    int m_maxFPS;
+    int m_evaluationWindow;
+
+    int m_currentFPS;
+    DetectionQuality m_quality;
+    double m_averageCost;
+    double m_windowCostSum;
+    int m_windowFrames;
+    int m_headroomWindows;
+    int m_adjustmentCount;
+
+    bool evaluate(double windowCost);
+};
+
+#endif // ADAPTIVEGOVERNOR_H
@@ -0,0 +1,79 @@
+#ifndef COLORCALIBRATOR_H
+#define COLORCALIBRATOR_H
+
+#include <QColor>
+#include <QtGlobal>
+#include <memory>
+#include <opencv2/opencv.hpp>
+#include <vector>
+#include "SettingsStore.h"
+
+struct ColorCalibration {
+    CalibratedColorRange range;     // Invalid if there were too few target pixels
+    QColor meanColor;               // Mean of the target pixels
+    double targetCoverage = 0.0;    // Share of target pixels inside the range
+    double backgroundRate = 0.0;    // Share of background pixels inside the range
+    quint64 targetPixels = 0;
+    quint64 backgroundPixels = 0;
+
+    // Back-projection model over the same samples; null when range is invalid
+    std::shared_ptr<const HueSatModel> hueSatModel;
+    double modelCoverage = 0.0;
+    double modelBackgroundRate = 0.0;
+};
+
+// Finds the tightest HSV box that keeps a given share of the sampled target
+// pixels while letting in as little of the sampled background as possible.
+// Samples go into coarse 3D HSV histograms; the search starts from the box
+// around the central target mass and greedily pulls in whichever face drops
+// the most background per target pixel lost. Box counts come from prefix
+// sums, so each candidate is O(1) and compute() takes well under a frame.
+//
+// The same histograms also yield a HueSatModel: within the box's value
+// range, hue-saturation cells are ranked by back-projected target
+// probability and accepted best first until the coverage is met. Shaded,
+// anti-aliased outlines that no single box fits tightly stay tight there.
+class ColorCalibrator {
+public:
+    ColorCalibrator();
+
+    void reset();
+
+    // BGR pixels; mask (CV_8U, optional) selects the ones that count
+    void addTarget(const cv::Mat& bgr, const cv::Mat& mask = cv::Mat());
+    void addBackground(const cv::Mat& bgr, const cv::Mat& mask = cv::Mat());
+
+    quint64 getTargetCount() const;
+    quint64 getBackgroundCount() const;
+
+    // Share of target pixels the range and the model have to keep; 0.95
+    // by default
+    void setMinTargetCoverage(double coverage);
+    double getMinTargetCoverage() const;
+
+    ColorCalibration compute() const;
+
+private:
+    // Bin widths: 2 hue units, 8 saturation/value units
+    static constexpr int kHueBins = 90;
+    static constexpr int kSatBins = 32;
+    static constexpr int kValBins = 32;
+    static constexpr quint64 kMinTargetPixels = 64;
+    static_assert(kHueBins == HueSatModel::kHueBins && kSatBins == HueSatModel::kSatBins,
+                  "Model cells are calibration histogram bins");
+    // Cells past the coverage target still join at this target probability
+    static constexpr double kBackProjectionThreshold = 0.9;
+
+    std::vector<quint32> m_target;
+    std::vector<quint32> m_background;
+    quint64 m_targetCount;
+    quint64 m_backgroundCount;
+    double m_targetSum[3];          // BGR, for the mean colour
+    double m_minTargetCoverage;
+
+    void buildHueSatModel(int lowerValueBin, int upperValueBin, ColorCalibration& result) const;
+    void accumulate(const cv::Mat& bgr, const cv::Mat& mask, std::vector<quint32>& histogram,
+                    quint64& count, double* colorSum);
+};
+
+#endif // COLORCALIBRATOR_H
@@ -7,7 +7,9 @@
 #include <QRect>
 #include <opencv2/opencv.hpp>
 #include <vector>
+#include <memory>
 #include <algorithm>
+#include "SettingsStore.h"
 
 struct DetectedTarget {
     QPoint center;
@@ -17,11 +19,32 @@ struct DetectedTarget {
     double area;
 };
 
+// Quality steps the adaptive governor can trade for speed
+enum class DetectionQuality {
+    Full = 0,           // Full resolution with morphology (if enabled)
+    NoMorphology,       // Full resolution, morphology skipped
+    HalfResolution,     // One pyramid level down, morphology skipped
+    QuarterResolution   // Two pyramid levels down, morphology skipped
+};
+
 struct ColorRange {
     cv::Scalar lower;
     cv::Scalar upper;
 };
 
+// Detection data derived from one settings snapshot. Built ahead of time
+// (for every profile) so adopting a snapshot costs nothing on the next frame.
+struct DetectionDerived {
+    QColor targetColor;
+    int colorTolerance;
+    CalibratedColorRange calibratedRange;
+    ColorRange colorRange;
+    int fovRadius;
+    cv::Size frameSize;             // Full-resolution frame the masks were built for
+    QPoint aimPoint;
+    cv::Mat fovMasks[3];            // Per pyramid level (Full/Half/Quarter resolution)
+};
+
 class ColorDetection : public QObject {
     Q_OBJECT
 
@@ -29,8 +52,20 @@ public:
     explicit ColorDetection(QObject* parent = nullptr);
     ~ColorDetection();
 
-    // Main detection method
-    std::vector<DetectedTarget> detect(const cv::Mat& frame, const QPoint& screenCenter);
+    // Main detection method. aimPoint and all results are in frame pixels;
+    // the FOV is centred on aimPoint
+    std::vector<DetectedTarget> detect(const cv::Mat& frame, const QPoint& aimPoint);
+
+    // Adopts a settings snapshot; a no-op unless its version changed. Cached
+    // colour range and FOV mask are rebuilt lazily on the next detect().
+    void applySettings(const DetectionSettings& settings);
+    quint64 getSettingsVersion() const;
+
+    // Builds the derived data for a snapshot, for frames of frameSize aimed
+    // at aimPoint. Touches no detector state, so any thread may call it.
+    static std::shared_ptr<const DetectionDerived> prepare(const DetectionSettings& settings,
+                                                          const cv::Size& frameSize,
+                                                          const QPoint& aimPoint);
 
     // Color settings
     void setTargetColor(const QColor& color);
@@ -39,6 +74,18 @@ public:
     void setColorTolerance(int tolerance);
     int getColorTolerance() const;
 
+    // Calibrated HSV box; while valid it replaces colour ± tolerance
+    void setCalibratedRange(const CalibratedColorRange& range);
+    CalibratedColorRange getCalibratedRange() const;
+
+    // Back-projection replaces the HSV box with a hue-saturation lookup;
+    // without a model the box is used
+    void setColorMatchMode(ColorMatchMode mode);
+    ColorMatchMode getColorMatchMode() const;
+
+    void setHueSatModel(const std::shared_ptr<const HueSatModel>& model);
+    std::shared_ptr<const HueSatModel> getHueSatModel() const;
+
     // FOV settings
     void setFOVRadius(int radius);
     int getFOVRadius() const;
@@ -53,10 +100,18 @@ public:
     void setMorphologyEnabled(bool enabled);
     bool isMorphologyEnabled() const;
 
+    void setQuality(DetectionQuality quality);
+    DetectionQuality getQuality() const;
+
     // Performance stats
     double getLastDetectionTime() const;
     int getLastTargetCount() const;
 
+    // targetDetected/detectionComplete fire every frame; off by default so
+    // the hot path emits nothing unless someone asks for them
+    void setSignalsEnabled(bool enabled);
+    bool isSignalsEnabled() const;
+
 signals:
     void targetDetected(const DetectedTarget& target);
     void detectionComplete(int targetCount, double timeMs);
@@ -64,17 +119,35 @@ signals:
 private:
     QColor m_targetColor;
     int m_colorTolerance;
+    CalibratedColorRange m_calibratedRange;
+    ColorMatchMode m_colorMatchMode;
+    std::shared_ptr<const HueSatModel> m_hueSatModel;
     int m_fovRadius;
     double m_minArea;
     double m_maxArea;
     bool m_morphologyEnabled;
+    DetectionQuality m_quality;
     double m_lastDetectionTime;
     int m_lastTargetCount;
-
-    ColorRange calculateColorRange(const QColor& color, int tolerance);
-    cv::Mat createFOVMask(const cv::Size& frameSize, const QPoint& center, int radius);
+    quint64 m_settingsVersion;
+    bool m_signalsEnabled;
+
+    // Derived from the settings above; only rebuilt when they change
+    ColorRange m_colorRange;
+    bool m_colorRangeDirty;
+    cv::Mat m_fovMask;
+    QPoint m_fovMaskCenter;
+    int m_fovMaskRadius;
+    std::shared_ptr<const DetectionDerived> m_derived;
+
+    static ColorRange calculateColorRange(const QColor& color, int tolerance);
+    static ColorRange resolveColorRange(const QColor& color, int tolerance, const CalibratedColorRange& calibrated);
+    static void applyColorRange(const cv::Mat& hsv, const ColorRange& range, cv::Mat& mask);
+    static void applyHueSatModel(const cv::Mat& hsv, const HueSatModel& model, cv::Mat& mask);
+    const cv::Mat& fovMask(const cv::Size& frameSize, const QPoint& center, int radius, int level);
+    static cv::Mat createFOVMask(const cv::Size& frameSize, const QPoint& center, int radius);
     cv::Mat applyMorphology(const cv::Mat& mask);
-    std::vector<DetectedTarget> findTargets(const cv::Mat& mask, const QPoint& screenCenter);
+    std::vector<DetectedTarget> findTargets(const cv::Mat& mask, const QPoint& aimPoint, int scale);
     double calculateConfidence(double area, double distanceFromCenter);
 };
 
@@ -0,0 +1,37 @@
+#ifndef COORDINATETRANSFORM_H
+#define COORDINATETRANSFORM_H
+
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+#include <cmath>
+
+// Maps between the pixels of one captured frame and global desktop
+// coordinates. ScreenCapture produces one per capture; detection works in
+// frame pixels and everything that touches the screen (mouse, overlay)
+// converts through the transform of the frame the data came from.
+//
+//   global = monitorOrigin + (frame + roiOffset) / scale
+struct CoordinateTransform {
+    QPoint monitorOrigin;       // Monitor top-left in global (logical) coordinates
+    QPoint roiOffset;           // Frame top-left within the monitor, in capture pixels
+    double scale = 1.0;         // Capture pixels per logical pixel (device pixel ratio)
+
+    QPoint frameToGlobal(const QPoint& point) const {
+        return QPoint(monitorOrigin.x() + static_cast<int>(std::lround((point.x() + roiOffset.x()) / scale)),
+                      monitorOrigin.y() + static_cast<int>(std::lround((point.y() + roiOffset.y()) / scale)));
+    }
+
+    QRect frameToGlobal(const QRect& rect) const {
+        QPoint topLeft = frameToGlobal(rect.topLeft());
+        QPoint bottomRight = frameToGlobal(rect.topLeft() + QPoint(rect.width(), rect.height()));
+        return QRect(topLeft, QSize(bottomRight.x() - topLeft.x(), bottomRight.y() - topLeft.y()));
+    }
+
+    QPoint globalToFrame(const QPoint& point) const {
+        return QPoint(static_cast<int>(std::lround((point.x() - monitorOrigin.x()) * scale)) - roiOffset.x(),
+                      static_cast<int>(std::lround((point.y() - monitorOrigin.y()) * scale)) - roiOffset.y());
+    }
+};
+
+#endif // COORDINATETRANSFORM_H
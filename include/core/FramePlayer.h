@@ -0,0 +1,50 @@
+#ifndef FRAMEPLAYER_H
+#define FRAMEPLAYER_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <opencv2/opencv.hpp>
+#include <vector>
+#include "FrameRecorder.h"
+
+class FramePlayer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit FramePlayer(QObject* parent = nullptr);
+    ~FramePlayer();
+
+    // File access
+    bool open(const QString& filePath);
+    void close();
+    bool isOpen() const;
+    QString getErrorString() const;
+
+    // Recording info
+    QByteArray getConfigSnapshot() const;
+    int getFrameCount() const;
+    qint64 getFrameTimestamp(int index) const;
+
+    // Returns a cv::Mat header over the mapped file for uncompressed frames
+    // (read-only, valid until close()). LZ4 frames are decoded into an internal
+    // buffer that is reused by the next frame() call.
+    cv::Mat frame(int index);
+
+private:
+    QFile m_file;
+    uchar* m_data;
+    quint64 m_size;
+    QByteArray m_configSnapshot;
+    std::vector<recording::FrameIndexEntry> m_index;
+    std::vector<uchar> m_decodeBuffer;
+    QString m_errorString;
+
+    bool readIndex();
+    bool rebuildIndex();
+    bool fail(const QString& error);
+    const recording::FrameChunkHeader* chunkAt(quint64 offset) const;
+};
+
+#endif // FRAMEPLAYER_H
@@ -0,0 +1,147 @@
+#ifndef FRAMERECORDER_H
+#define FRAMERECORDER_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Recording file layout (little-endian, native struct packing disabled):
+//
+//   RecordingHeader
+//   config snapshot (UTF-8 JSON, configSize bytes)
+//   FrameChunkHeader + padding + payload      (repeated per frame)
+//   FrameIndexEntry[frameCount]
+//   RecordingTrailer
+//
+// Every payload starts on a kPayloadAlignment boundary so playback can wrap
+// uncompressed frames in cv::Mat headers directly over the mapped file.
+
+namespace recording {
+
+constexpr char kFileMagic[8] = {'A', 'G', 'A', 'R', 'E', 'C', '0', '1'};
+constexpr quint32 kFormatVersion = 1;
+constexpr quint32 kChunkMagic = 0x454D5246;   // "FRME"
+constexpr quint32 kTrailerMagic = 0x58444E49; // "INDX"
+constexpr quint64 kPayloadAlignment = 64;
+
+enum ChunkFlags : quint32 {
+    ChunkCompressedLZ4 = 0x1
+};
+
+#pragma pack(push, 1)
+struct RecordingHeader {
+    char magic[8];
+    quint32 version;
+    quint32 configSize;
+};
+
+struct FrameChunkHeader {
+    quint32 magic;
+    quint32 flags;
+    quint64 frameIndex;
+    qint64 timestampNs;
+    qint32 width;
+    qint32 height;
+    qint32 type;        // OpenCV matrix type (CV_8UC3 / CV_8UC4)
+    quint32 step;       // Bytes per row of the decoded frame
+    quint32 rawSize;    // Decoded payload size
+    quint32 storedSize; // Bytes actually stored after the header
+};
+
+struct FrameIndexEntry {
+    quint64 chunkOffset;
+    qint64 timestampNs;
+};
+
+struct RecordingTrailer {
+    quint64 indexOffset;
+    quint64 frameCount;
+    quint32 magic;
+};
+#pragma pack(pop)
+
+inline quint64 alignPayload(quint64 offset) {
+    return (offset + kPayloadAlignment - 1) & ~(kPayloadAlignment - 1);
+}
+
+} // namespace recording
+
+class FrameRecorder : public QObject {
+    Q_OBJECT
+
+public:
+    explicit FrameRecorder(QObject* parent = nullptr);
+    ~FrameRecorder();
+
+    // Session control
+    bool start(const QString& filePath, const QByteArray& configSnapshot);
+    void stop();
+    bool isRecording() const;
+    QString getFilePath() const;
+
+    // Queues a frame for the writer thread. The frame is shared, not copied,
+    // so the caller must not write into its buffer afterwards. Returns false
+    // if the frame was dropped because the queue is full.
+    bool pushFrame(const cv::Mat& frame, qint64 timestampNs);
+
+    // Settings
+    void setCompressionEnabled(bool enabled);
+    bool isCompressionEnabled() const;
+    static bool isCompressionAvailable();
+
+    void setMaxQueuedFrames(int frames);
+    int getMaxQueuedFrames() const;
+
+    // Stats
+    quint64 getFramesWritten() const;
+    quint64 getFramesDropped() const;
+    quint64 getBytesWritten() const;
+
+signals:
+    void recordingStarted(const QString& filePath);
+    void recordingStopped(quint64 framesWritten);
+    void recordingError(const QString& error);
+
+private:
+    struct PendingFrame {
+        cv::Mat image;
+        qint64 timestampNs;
+    };
+
+    QFile m_file;
+    QString m_filePath;
+    bool m_compressionEnabled;
+    int m_maxQueuedFrames;
+
+    std::thread m_writerThread;
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCondition;
+    std::deque<PendingFrame> m_queue;
+    bool m_stopRequested;
+    std::atomic<bool> m_isRecording;
+
+    // Writer thread state
+    std::vector<recording::FrameIndexEntry> m_index;
+    std::vector<char> m_scratch;
+    quint64 m_writeOffset;
+
+    std::atomic<quint64> m_framesWritten;
+    std::atomic<quint64> m_framesDropped;
+    std::atomic<quint64> m_bytesWritten;
+
+    void writerLoop();
+    bool writeFrame(const PendingFrame& pending);
+    bool writeIndex();
+    bool writeBytes(const void* data, qint64 size);
+    bool writePadding(quint64 alignedOffset);
+};
+
+#endif // FRAMERECORDER_H
@@ -0,0 +1,91 @@
+#ifndef INPUTSINK_H
+#define INPUTSINK_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Destination for everything MouseController actuates. Implementations must
+// be callable from the actuation thread as well as the GUI thread.
+class InputSink {
+public:
+    virtual ~InputSink() = default;
+
+    virtual void moveAbsolute(int x, int y) = 0;
+    virtual void moveRelative(int dx, int dy) = 0;
+    virtual void buttonEvent(Qt::MouseButton button, bool pressed) = 0;
+    virtual QPoint cursorPosition() const = 0;
+
+    // Press + release; platforms that can batch both override this
+    virtual void click(Qt::MouseButton button);
+};
+
+// Moves the real cursor (SetCursorPos/SendInput on Windows, QCursor elsewhere).
+// QCursor moves from other threads are coalesced: only the newest position
+// is kept and at most one hand-over to the GUI thread is queued at a time.
+class PlatformInputSink : public InputSink {
+public:
+    PlatformInputSink();
+
+    void moveAbsolute(int x, int y) override;
+    void moveRelative(int dx, int dy) override;
+    void buttonEvent(Qt::MouseButton button, bool pressed) override;
+    QPoint cursorPosition() const override;
+    void click(Qt::MouseButton button) override;
+
+private:
+    // Shared with the queued call, which may outlive the sink
+    struct PendingMove {
+        std::atomic<quint64> position{0};      // x in the high, y in the low 32 bits
+        std::atomic<bool> queued{false};
+    };
+    std::shared_ptr<PendingMove> m_pendingMove;
+};
+
+// Records actuation in memory against a simulated cursor, for replay tests
+// and benchmarks on machines where the real cursor must not move
+class RecordingInputSink : public InputSink {
+public:
+    enum class EventType {
+        MoveAbsolute,
+        MoveRelative,
+        ButtonDown,
+        ButtonUp
+    };
+
+    struct Event {
+        EventType type;
+        QPoint position;    // Simulated cursor position after the event
+        QPoint delta;       // Requested offset for relative moves
+        Qt::MouseButton button;
+        qint64 timestampNs; // steady_clock
+    };
+
+    explicit RecordingInputSink(const QPoint& initialPosition = QPoint(0, 0));
+
+    void moveAbsolute(int x, int y) override;
+    void moveRelative(int dx, int dy) override;
+    void buttonEvent(Qt::MouseButton button, bool pressed) override;
+    QPoint cursorPosition() const override;
+
+    // Recorded data
+    std::vector<Event> getEvents() const;
+    size_t getEventCount() const;
+    void clear();
+
+    // Pre-size the event buffer so recording doesn't allocate mid-benchmark
+    void reserve(size_t events);
+    void setCursorPosition(const QPoint& position);
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<Event> m_events;
+    QPoint m_position;
+
+    void record(EventType type, const QPoint& delta, Qt::MouseButton button);
+};
+
+#endif // INPUTSINK_H
@@ -0,0 +1,35 @@
+#ifndef LATENCYWINDOW_H
+#define LATENCYWINDOW_H
+
+#include <vector>
+#include <cstddef>
+
+struct LatencyPercentiles {
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+};
+
+// Fixed-size ring of the most recent latency samples (ms). Adding a sample
+// never allocates; percentiles are computed on demand from a scratch copy,
+// which is meant for a few queries per second, not per frame.
+class LatencyWindow {
+public:
+    explicit LatencyWindow(size_t capacity = 512);
+
+    void add(double ms);
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const;
+
+    LatencyPercentiles percentiles() const;
+
+private:
+    std::vector<double> m_samples;
+    size_t m_next;
+    size_t m_count;
+    mutable std::vector<double> m_scratch;
+};
+
+#endif // LATENCYWINDOW_H
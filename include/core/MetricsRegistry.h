@@ -0,0 +1,75 @@
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include <QByteArray>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+
+// Lock-free metric storage shared between the pipeline (writer) and the
+// metrics endpoint (reader, on its own thread). Every observation is a
+// handful of relaxed atomic adds; rendering reads whatever is current.
+class MetricsRegistry {
+public:
+    enum class Stage {
+        Capture = 0,
+        Detect,
+        Frame,
+        Count
+    };
+
+    enum class Counter {
+        Frames = 0,
+        TargetsDetected,
+        Assists,
+        StaleFramesDropped,
+        StaleDetectionsDropped,
+        FrameBufferAllocations,
+        VoluntaryContextSwitches,
+        InvoluntaryContextSwitches,
+        PageFaults,
+        Count
+    };
+
+    enum class Gauge {
+        FPS = 0,
+        TargetFPS,
+        GovernedFPS,
+        DetectionQuality,
+        ResidentMemoryBytes,
+        PeakResidentMemoryBytes,
+        ProcessCPUPercent,
+        UIRetranslateMs,
+        OverlayPaintMs,
+        Count
+    };
+
+    MetricsRegistry();
+
+    // Writer side
+    void observe(Stage stage, double ms);
+    void increment(Counter counter, quint64 amount = 1);
+    // For counters whose running total is kept elsewhere (e.g. by the OS)
+    void setTotal(Counter counter, quint64 total);
+    void set(Gauge gauge, double value);
+
+    // Prometheus text exposition format (version 0.0.4)
+    QByteArray renderPrometheus() const;
+
+private:
+    // Upper bounds in ms; the last bucket is +Inf
+    static constexpr int kBucketCount = 10;
+    static const std::array<double, kBucketCount - 1> kBucketBounds;
+
+    struct Histogram {
+        std::array<std::atomic<quint64>, kBucketCount> buckets;
+        std::atomic<quint64> count;
+        std::atomic<quint64> sumNs;
+    };
+
+    std::array<Histogram, static_cast<size_t>(Stage::Count)> m_histograms;
+    std::array<std::atomic<quint64>, static_cast<size_t>(Counter::Count)> m_counters;
+    std::array<std::atomic<double>, static_cast<size_t>(Gauge::Count)> m_gauges;
+};
+
+#endif // METRICSREGISTRY_H
@@ -3,14 +3,16 @@
 
 #include <QObject>
 #include <QPoint>
-#include <QTimer>
 #include <vector>
 #include <random>
 #include <algorithm>
-
-#ifdef _WIN32
-#include <windows.h>
-#endif
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "InputSink.h"
 
 struct BezierPoint {
     double x;
@@ -38,6 +40,11 @@ public:
 
     void applyAimAssist(const QPoint& targetPos);
 
+    // Output: defaults to PlatformInputSink; swap in a RecordingInputSink to
+    // exercise actuation without moving the real cursor
+    void setInputSink(std::shared_ptr<InputSink> sink);
+    std::shared_ptr<InputSink> getInputSink() const;
+
     // Mouse state
     QPoint getCurrentPosition() const;
     bool isMoving() const;
@@ -63,14 +70,25 @@ signals:
 private:
     int m_aimAssistStrength;
     int m_responseSpeed;
-    bool m_isMoving;
+    std::atomic<bool> m_isMoving;
     bool m_humanizeEnabled;
     double m_randomizationFactor;
-    QTimer* m_movementTimer;
-    std::vector<BezierPoint> m_currentPath;
-    int m_pathIndex;
     QPoint m_targetPosition;
 
+    // Path playback runs on a dedicated actuation thread. Positions are
+    // derived from elapsed time, so playback takes durationMs regardless of
+    // how often the thread actually gets to run.
+    std::thread m_actuationThread;
+    mutable std::mutex m_pathMutex;
+    std::condition_variable m_pathCondition;
+    std::vector<BezierPoint> m_currentPath;
+    std::chrono::steady_clock::time_point m_pathStart;
+    std::chrono::steady_clock::duration m_pathDuration;
+    quint64 m_pathGeneration;
+    bool m_pathActive;
+    bool m_stopActuation;
+    std::shared_ptr<InputSink> m_inputSink;
+
     std::mt19937 m_rng;
     std::uniform_real_distribution<double> m_distribution;
 
@@ -79,17 +97,14 @@ private:
     BezierPoint bezierPoint(double t, const BezierPoint& p0, const BezierPoint& p1, 
                             const BezierPoint& p2, const BezierPoint& p3);
 
+    static BezierPoint samplePath(const std::vector<BezierPoint>& path, double t);
+
     // Human-like movement
     void addMicroMovements(std::vector<BezierPoint>& path);
     double getRandomDelay();
     QPoint addRandomOffset(const QPoint& point, double maxOffset);
 
-    // Platform-specific movement
-    void platformMove(int x, int y);
-    void platformMoveRelative(int dx, int dy);
-
-private slots:
-    void onMovementTick();
+    void actuationLoop();
 };
 
 #endif // MOUSECONTROLLER_H
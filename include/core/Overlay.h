@@ -2,27 +2,26 @@
 #define OVERLAY_H
 
 #include <QWidget>
-#include <QTimer>
 #include <QPainter>
+#include <QPixmap>
 #include <QPaintEvent>
-#include <QShowEvent>
 #include <QPoint>
 #include <QRect>
+#include <QRegion>
 #include <QColor>
+#include <QFont>
+#include <QStringList>
+#include <QTimer>
+#include <functional>
 #include <vector>
 #include <algorithm>
+#include "TargetFeed.h"
+#include "PipelineStats.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
-struct OverlayTarget {
-    QPoint position;
-    QRect boundingBox;
-    QColor color;
-    bool isSelected;
-};
-
 class Overlay : public QWidget {
     Q_OBJECT
 
@@ -41,9 +40,14 @@ public:
     bool isFOVVisible() const;
 
     // Target indicators
+    // Target coordinates are global desktop coordinates
     void setTargets(const std::vector<OverlayTarget>& targets);
     void clearTargets();
 
+    // Follow the pipeline's latest targets; the feed must outlive the overlay
+    // or be detached with setTargetFeed(nullptr)
+    void setTargetFeed(TargetFeed* feed);
+
     void setTargetIndicatorVisible(bool visible);
     bool isTargetIndicatorVisible() const;
 
@@ -63,12 +67,44 @@ public:
 
     void updatePosition();
 
+    // Monitor being captured (global geometry); the overlay follows it
+    void setCaptureMonitor(const QRect& geometry);
+    QRect getCaptureMonitor() const;
+
+    // Cover only the FOV square instead of the whole monitor
+    void setFOVOnlyGeometry(bool enabled);
+    bool isFOVOnlyGeometry() const;
+
+    // Static elements (FOV ring, crosshair) are rasterised once into cached
+    // layers and blitted per paint; disable to stroke them live for comparison
+    void setLayerCachingEnabled(bool enabled);
+    bool isLayerCachingEnabled() const;
+
+    // Performance HUD below the FOV, sampled from the provider at 4 Hz and
+    // drawn from a cached text layer
+    void setHUDVisible(bool visible);
+    bool isHUDVisible() const;
+    void setHUDStatsProvider(std::function<PipelineStats()> provider);
+    // One format per HUD line (FPS, capture, detect, frame, dropped, targets);
+    // lets the UI supply translated text. Defaults to English.
+    void setHUDFormats(const QStringList& formats);
+
+    // Paint cost (ms) measured inside paintEvent
+    double getLastPaintTime() const;
+    double getAveragePaintTime() const;
+    int getPaintCount() const;
+    void resetPaintStats();
+
 public slots:
+    // Forces a full repaint; normal changes only repaint their dirty area
     void refresh();
 
+private slots:
+    void onTargetsPublished();
+    void refreshHUD();
+
 protected:
     void paintEvent(QPaintEvent* event) override;
-    void showEvent(QShowEvent* event) override;
 
 private:
     int m_fovRadius;
@@ -77,18 +113,66 @@ private:
 
     std::vector<OverlayTarget> m_targets;
     bool m_targetIndicatorVisible;
+    TargetFeed* m_targetFeed;
+    std::vector<OverlayTarget> m_incomingTargets;  // Reused mapping buffer
 
     bool m_crosshairVisible;
     QColor m_crosshairColor;
     int m_crosshairSize;
 
     bool m_overlayEnabled;
-    QTimer* m_refreshTimer;
+
+    // Placement
+    QRect m_monitorGeometry;
+    bool m_fovOnlyGeometry;
+
+    // Pre-rendered static layers, rebuilt lazily when their inputs change
+    bool m_layerCachingEnabled;
+    QPixmap m_fovLayer;
+    QPixmap m_crosshairLayer;
+    bool m_fovLayerDirty;
+    bool m_crosshairLayerDirty;
+
+    // HUD
+    bool m_hudVisible;
+    QTimer* m_hudTimer;
+    std::function<PipelineStats()> m_hudStatsProvider;
+    QFont m_hudFont;
+    QSize m_hudSize;
+    QString m_hudText;
+    QPixmap m_hudLayer;
+    bool m_hudLayerDirty;
+    QStringList m_hudFormats;
+
+    // Paint timing
+    double m_lastPaintTime;
+    double m_paintTimeSum;
+    int m_paintCount;
 
     void setupOverlayWindow();
-    void drawFOVCircle(QPainter& painter);
-    void drawTargets(QPainter& painter);
-    void drawCrosshair(QPainter& painter);
+
+    QRect monitorRect() const;
+    QPoint desktopCenter() const;
+    QPoint fovCenter() const;
+    QRect overlayGeometry() const;
+    QPoint mapFromDesktop(const QPoint& point) const;
+    QRect mapFromDesktop(const QRect& rect) const;
+
+    // Dirty-area helpers (widget coordinates, padded for pen width and AA)
+    QRect fovRect() const;
+    QRect crosshairRect() const;
+    QRect hudRect() const;
+    QRect targetRect(const OverlayTarget& target) const;
+    QRegion targetsRegion(const std::vector<OverlayTarget>& targets) const;
+
+    void drawFOVCircle(QPainter& painter, const QPoint& center);
+    void drawTargets(QPainter& painter, const QRegion& dirty);
+    void drawCrosshair(QPainter& painter, const QPoint& center);
+
+    QPixmap renderLayer(const QSize& size, void (Overlay::*draw)(QPainter&, const QPoint&));
+    void drawFOVLayer(QPainter& painter);
+    void drawCrosshairLayer(QPainter& painter);
+    void drawHUDLayer(QPainter& painter);
 
 #ifdef _WIN32
     void makeClickThrough();
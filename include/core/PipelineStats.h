@@ -0,0 +1,41 @@
+#ifndef PIPELINESTATS_H
+#define PIPELINESTATS_H
+
+#include "ColorDetection.h"
+#include "LatencyWindow.h"
+
+// Snapshot of pipeline performance, emitted by Tracker once per stats interval
+struct PipelineStats {
+    // Throughput
+    double fps = 0.0;
+    int targetFPS = 0;
+    int governedFPS = 0;
+
+    // Average stage cost over the interval (ms)
+    double captureTimeMs = 0.0;
+    double detectTimeMs = 0.0;
+    double frameCostMs = 0.0;
+    double maxFrameCostMs = 0.0;
+
+    // Rolling percentiles over the most recent frames (ms)
+    LatencyPercentiles captureLatency;
+    LatencyPercentiles detectLatency;
+    LatencyPercentiles frameLatency;
+
+    // Adaptive governor state
+    bool governorEnabled = false;
+    DetectionQuality quality = DetectionQuality::Full;
+    double latencyBudgetMs = 0.0;
+    int governorAdjustments = 0;
+
+    // Deadline policy
+    int maxFrameAgeMs = 0;
+    int staleFramesDropped = 0;
+    int staleDetectionsDropped = 0;
+
+    // Totals
+    int totalTargets = 0;
+    int totalAssists = 0;
+};
+
+#endif // PIPELINESTATS_H
@@ -0,0 +1,60 @@
+#ifndef PIXELSAMPLER_H
+#define PIXELSAMPLER_H
+
+#include <QObject>
+#include <QColor>
+#include <QImage>
+#include <QTimer>
+#include <opencv2/opencv.hpp>
+#include <memory>
+
+class ScreenCapture;
+
+// Samples a small patch of screen around the cursor for the colour
+// pickers, at display rate on Windows. One capture per tick serves the
+// magnifier, the picked pixel and patch averages alike. Uses the given
+// ScreenCapture (normally the tracker's) or, without one, a private
+// instance.
+class PixelSampler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit PixelSampler(ScreenCapture* capture = nullptr, QObject* parent = nullptr);
+    ~PixelSampler();
+
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    // 16 ms (about 60 Hz) by default on Windows, 50 ms elsewhere
+    void setInterval(int intervalMs);
+    int getInterval() const;
+
+    // Patch is (2 * radius + 1)² pixels; 7 by default
+    void setPatchRadius(int radius);
+    int getPatchRadius() const;
+
+    // Captures once now; sampled() is emitted on success
+    bool sample();
+
+    // Last patch, BGR and centred on the cursor; empty before the first sample
+    const cv::Mat& getPatch() const;
+    QImage getPatchImage() const;
+
+    QColor getCenterColor() const;
+    // Mean over the (2 * radius + 1)² pixels around the centre; 0 is the
+    // centre pixel alone
+    QColor getAverageColor(int radius) const;
+
+signals:
+    void sampled();
+
+private:
+    ScreenCapture* m_capture;
+    std::unique_ptr<ScreenCapture> m_ownedCapture;
+    QTimer* m_sampleTimer;
+    int m_patchRadius;
+    cv::Mat m_patch;
+};
+
+#endif // PIXELSAMPLER_H
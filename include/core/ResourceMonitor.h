@@ -0,0 +1,57 @@
+#ifndef RESOURCEMONITOR_H
+#define RESOURCEMONITOR_H
+
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+struct ThreadResourceSample {
+    qint64 threadId = 0;
+    QString name;
+    qint64 cpuTimeUs = 0;               // User + kernel, cumulative
+    double cpuPercent = 0.0;            // Of one core, since the previous sample
+    quint64 voluntarySwitches = 0;      // Cumulative; Linux only
+    quint64 involuntarySwitches = 0;
+};
+
+struct ResourceSample {
+    qint64 timestampMs = 0;
+    qint64 cpuTimeUs = 0;               // Whole process, cumulative
+    double cpuPercent = 0.0;
+    quint64 residentBytes = 0;
+    quint64 peakResidentBytes = 0;
+    quint64 voluntarySwitches = 0;      // Cumulative; 0 where the OS doesn't report them
+    quint64 involuntarySwitches = 0;
+    quint64 minorFaults = 0;            // Cumulative; Windows reports all faults here
+    quint64 majorFaults = 0;
+    std::vector<ThreadResourceSample> threads;     // Sorted by thread id
+};
+
+// Samples OS-level resource usage of this process. Linux reads /proc/self
+// (status, stat and each task's stat/status), Windows uses
+// GetProcessMemoryInfo and GetThreadTimes over a thread snapshot, and other
+// platforms fall back to getrusage without per-thread data. Meant to be
+// called about once a second from one thread; buffers are reused between
+// samples.
+class ResourceMonitor {
+public:
+    ResourceMonitor();
+
+    const ResourceSample& sample();
+    const ResourceSample& getLastSample() const;
+
+    // Names the calling thread so it can be told apart in samples (and in
+    // debuggers). Linux truncates names to 15 characters.
+    static void setCurrentThreadName(const char* name);
+
+private:
+    ResourceSample m_last;
+    ResourceSample m_next;
+    qint64 m_lastSampleNs;
+
+    void sampleProcess(ResourceSample& sample) const;
+    void sampleThreads(ResourceSample& sample) const;
+    void computeCpuPercent(ResourceSample& sample, qint64 elapsedNs) const;
+};
+
+#endif // RESOURCEMONITOR_H
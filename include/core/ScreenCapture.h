@@ -11,6 +11,7 @@
 #include <opencv2/opencv.hpp>
 #include <vector>
 #include <memory>
+#include "CoordinateTransform.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -22,6 +23,7 @@ struct MonitorInfo {
     QRect geometry;
     bool isPrimary;
     qreal dpi;
+    qreal devicePixelRatio;     // Physical pixels per logical pixel
 };
 
 class ScreenCapture : public QObject {
@@ -36,6 +38,12 @@ public:
     cv::Mat captureRegion(const QRect& region);
     cv::Mat captureFOV(int centerX, int centerY, int radius);
 
+    // (2 * radius + 1)² BGR patch centred on the mouse cursor, for colour
+    // pickers. Works in global coordinates on any monitor and leaves the
+    // tracker's frame state (transform, stats) alone, so the tracker's
+    // instance can be shared; out's buffer is reused when its size matches.
+    bool capturePatchAtCursor(int radius, cv::Mat& out);
+
     // Monitor management
     std::vector<MonitorInfo> getMonitors() const;
     void setActiveMonitor(int index);
@@ -46,8 +54,17 @@ public:
     QSize getScreenSize() const;
     QPoint getScreenCenter() const;
 
+    // Maps the last captured frame's pixels to global coordinates
+    CoordinateTransform getLastTransform() const;
+    double getCaptureScale() const;
+    static double getCaptureScale(const MonitorInfo& monitor);
+
     // Performance
     double getLastCaptureTime() const;
+    // Frame buffers allocated so far. Output buffers are reused across
+    // captures unless a consumer still holds the previous frame or the
+    // size changed; only those cases count.
+    quint64 getBufferAllocations() const;
 
 signals:
     void monitorChanged(int index);
@@ -56,7 +73,11 @@ signals:
 private:
     int m_activeMonitor;
     double m_lastCaptureTime;
+    quint64 m_bufferAllocations;
+    CoordinateTransform m_lastTransform;
     std::vector<MonitorInfo> m_monitors;
+    cv::Mat m_frameBuffer;
+    cv::Mat m_regionBuffer;
 
 #ifdef _WIN32
     HDC m_screenDC;
@@ -66,6 +87,12 @@ private:
     int m_captureWidth;
     int m_captureHeight;
 
+    // Cursor patches, sized on first use
+    HDC m_patchDC;
+    HBITMAP m_patchBitmap;
+    void* m_patchData;
+    int m_patchSize;
+
     void initWindowsCapture();
     void cleanupWindowsCapture();
     cv::Mat captureWindows();
@@ -73,6 +100,8 @@ private:
 #endif
 
     void detectMonitors();
+    cv::Mat& reuseBuffer(cv::Mat& buffer, int rows, int cols);
+    CoordinateTransform makeTransform(const QPoint& roiOffset) const;
     QImage convertToQImage(const cv::Mat& mat);
     cv::Mat convertToCvMat(const QImage& image);
 };
@@ -0,0 +1,143 @@
+#ifndef SETTINGSSTORE_H
+#define SETTINGSSTORE_H
+
+#include <QColor>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct DetectionDerived;
+
+// HSV box found by colour calibration, in OpenCV units (H 0-179, S and V
+// 0-255). A lower hue above the upper hue wraps around red.
+struct CalibratedColorRange {
+    bool valid = false;
+    std::array<int, 3> lower = {{0, 0, 0}};
+    std::array<int, 3> upper = {{0, 0, 0}};
+
+    bool operator==(const CalibratedColorRange& other) const {
+        return valid == other.valid && (!valid || (lower == other.lower && upper == other.upper));
+    }
+    bool operator!=(const CalibratedColorRange& other) const {
+        return !(*this == other);
+    }
+};
+
+// Hue-saturation classifier learned by colour calibration: the back-projected
+// target/background histogram, thresholded into accepted cells of 2 hue by
+// 8 saturation units, plus the value range the target was sampled in. Both
+// are kept as lookup tables, so classifying a pixel is two loads and an AND.
+struct HueSatModel {
+    static constexpr int kHueBins = 90;
+    static constexpr int kSatBins = 32;
+
+    std::array<uchar, kHueBins * kSatBins> cells = {};     // 255 = target
+    int minValue = 0;
+    int maxValue = 255;
+    std::array<uchar, 256> valueMask = {};                 // 255 inside [minValue, maxValue]
+
+    static int cellIndex(int hue, int saturation) {
+        return (hue >> 1) * kSatBins + (saturation >> 3);
+    }
+
+    void setValueRange(int lower, int upper) {
+        minValue = lower;
+        maxValue = upper;
+        for (int value = 0; value < 256; ++value) {
+            valueMask[value] = (value >= lower && value <= upper) ? 255 : 0;
+        }
+    }
+
+    bool operator==(const HueSatModel& other) const {
+        return minValue == other.minValue && maxValue == other.maxValue && cells == other.cells;
+    }
+    bool operator!=(const HueSatModel& other) const {
+        return !(*this == other);
+    }
+};
+
+enum class ColorMatchMode {
+    Range,              // HSV box: colour ± tolerance, or the calibrated range
+    BackProjection      // HueSatModel lookup; falls back to Range without a model
+};
+
+// Everything the pipeline reads that the UI can change. Snapshots are
+// immutable once published; version increases with every publish.
+struct DetectionSettings {
+    quint64 version = 0;
+
+    // Detection
+    QColor targetColor = Qt::red;
+    int colorTolerance = 30;
+    int fovRadius = 150;
+    double minArea = 50.0;
+    double maxArea = 50000.0;
+    bool morphologyEnabled = true;
+    // Replaces targetColor ± colorTolerance while valid
+    CalibratedColorRange calibratedRange;
+    ColorMatchMode colorMatchMode = ColorMatchMode::Range;
+    std::shared_ptr<const HueSatModel> hueSatModel;     // Immutable once shared
+
+    // Aim assist
+    int aimAssistStrength = 30;
+    int responseSpeed = 50;
+
+    // Optional precomputed colour range and FOV masks (see
+    // ColorDetection::prepare). Shared, so copying a snapshot is cheap;
+    // the detector checks it still matches before using it.
+    std::shared_ptr<const DetectionDerived> derived;
+};
+
+// RCU-style publication of DetectionSettings. Writers (the UI) copy the
+// current snapshot, change it and publish the copy with an atomic pointer
+// swap; the single reader (the pipeline) picks up the newest snapshot once
+// per frame with one atomic load and never locks. Replaced snapshots are
+// freed by the next writer once the reader has moved past them.
+class SettingsStore {
+public:
+    explicit SettingsStore(const DetectionSettings& initial = DetectionSettings());
+    ~SettingsStore();
+
+    SettingsStore(const SettingsStore&) = delete;
+    SettingsStore& operator=(const SettingsStore&) = delete;
+
+    // Writer side; any thread
+    DetectionSettings get() const;
+    void publish(const DetectionSettings& settings);
+
+    template<typename Mutator>
+    void update(Mutator&& mutate) {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        DetectionSettings next = *m_current.load(std::memory_order_acquire);
+        mutate(next);
+        publishLocked(next);
+    }
+
+    // Reader side; one thread at a time. The returned snapshot stays valid
+    // until the next acquire() or detachReader() from that thread; detach
+    // when the reader stops so replaced snapshots can be freed meanwhile.
+    const DetectionSettings& acquire();
+    void detachReader();
+
+    quint64 getVersion() const;
+
+private:
+    // Reader version while no reader is attached: everything retired is free
+    static constexpr quint64 kNoReader = ~quint64(0);
+
+    std::atomic<const DetectionSettings*> m_current;
+    std::atomic<quint64> m_readerVersion;
+    const DetectionSettings* m_readerSnapshot;     // Reader-owned
+
+    mutable std::mutex m_writerMutex;
+    quint64 m_nextVersion;
+    std::vector<std::unique_ptr<const DetectionSettings>> m_retired;
+
+    void publishLocked(const DetectionSettings& settings);
+    void reclaimLocked();
+};
+
+#endif // SETTINGSSTORE_H
@@ -0,0 +1,67 @@
+#ifndef TARGETFEED_H
+#define TARGETFEED_H
+
+#include <QPoint>
+#include <QRect>
+#include <QColor>
+#include <QtGlobal>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+struct OverlayTarget {
+    QPoint position;
+    QRect boundingBox;
+    QColor color;
+    bool isSelected;
+
+    bool operator==(const OverlayTarget& other) const {
+        return position == other.position && boundingBox == other.boundingBox &&
+               color == other.color && isSelected == other.isSelected;
+    }
+    bool operator!=(const OverlayTarget& other) const { return !(*this == other); }
+};
+
+struct TargetSnapshot {
+    std::vector<OverlayTarget> targets;     // Global desktop coordinates
+    quint64 sequence = 0;
+    qint64 timestampNs = 0;     // Capture time of the frame the targets came from
+};
+
+// Single-producer/single-consumer triple buffer for the latest target set.
+// The pipeline fills writeBuffer() and publishes; the overlay acquires the
+// newest snapshot whenever it gets round to it. Neither side blocks or
+// allocates once the buffers have grown to their working size, and at most
+// one wakeup is outstanding no matter how fast snapshots are published.
+class TargetFeed {
+public:
+    explicit TargetFeed(size_t reserveTargets = 64);
+
+    // Called (from the publishing thread) when a snapshot is published and
+    // no wakeup is pending. Set it before publishing starts.
+    void setNotifier(std::function<void()> notifier);
+
+    // Producer side
+    TargetSnapshot& writeBuffer();
+    void publish();
+
+    // Consumer side: returns true if a newer snapshot was swapped in
+    bool acquire();
+    const TargetSnapshot& readBuffer() const;
+
+    quint64 getPublishedCount() const;
+
+private:
+    static constexpr int kIndexMask = 0x3;
+    static constexpr int kFreshBit = 0x4;
+
+    TargetSnapshot m_buffers[3];
+    int m_writeIndex;                   // Producer-owned
+    int m_readIndex;                    // Consumer-owned
+    std::atomic<int> m_middle;          // Index of the shared buffer | fresh bit
+    std::atomic<bool> m_notifyPending;
+    std::atomic<quint64> m_sequence;
+    std::function<void()> m_notifier;
+};
+
+#endif // TARGETFEED_H
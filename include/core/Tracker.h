@@ -7,10 +7,17 @@
 #include <QElapsedTimer>
 #include <memory>
 #include <vector>
+#include <map>
 #include <algorithm>
 #include "ScreenCapture.h"
 #include "ColorDetection.h"
 #include "MouseController.h"
+#include "FrameRecorder.h"
+#include "AdaptiveGovernor.h"
+#include "PipelineStats.h"
+#include "TargetFeed.h"
+#include "MetricsRegistry.h"
+#include "SettingsStore.h"
 
 class Tracker : public QObject {
     Q_OBJECT
@@ -29,6 +36,26 @@ public:
     ScreenCapture* screenCapture() const;
     ColorDetection* colorDetection() const;
     MouseController* mouseController() const;
+    FrameRecorder* frameRecorder() const;
+    AdaptiveGovernor* adaptiveGovernor() const;
+    TargetFeed* targetFeed() const;
+    MetricsRegistry* metricsRegistry() const;
+
+    // Detection and aim assist settings. Publish changes here rather than
+    // through the components: the pipeline adopts the newest snapshot at
+    // the start of each frame.
+    SettingsStore* settingsStore() const;
+
+    // Profiles are prepared ahead of time, derived detection data included,
+    // so activating one is a single snapshot swap for the pipeline
+    void prepareProfile(const QString& name, const DetectionSettings& settings, int monitorIndex);
+    void removeProfile(const QString& name);
+    bool activateProfile(const QString& name);
+
+    // Recording (FOV frames are written by a background thread)
+    bool startRecording(const QString& filePath);
+    void stopRecording();
+    bool isRecording() const;
 
     // Settings
     void setTargetFPS(int fps);
@@ -37,11 +64,39 @@ public:
     void setEnabled(bool enabled);
     bool isEnabled() const;
 
+    // Adaptive FPS governor (target FPS becomes the upper bound)
+    void setAdaptiveFPSEnabled(bool enabled);
+    bool isAdaptiveFPSEnabled() const;
+
+    void setLatencyBudget(double budgetMs);
+    double getLatencyBudget() const;
+
+    // Capture only the FOV square instead of the whole monitor
+    void setROICaptureEnabled(bool enabled);
+    bool isROICaptureEnabled() const;
+
+    // Deadline: frames and detections older than this are dropped (0 = off)
+    void setMaxFrameAge(int ageMs);
+    int getMaxFrameAge() const;
+
     // Stats
     double getCurrentFPS() const;
     int getTotalTargetsDetected() const;
     int getTotalAssists() const;
+    int getStaleFramesDropped() const;
+    int getStaleDetectionsDropped() const;
     qint64 getRunningTimeMs() const;
+    PipelineStats getPipelineStats() const;
+
+    // Last snapshot refreshed with current counters and rolling percentiles;
+    // cheap enough to poll a few times per second
+    PipelineStats getLivePipelineStats() const;
+
+    // Per-frame signals (targetFound, assistApplied and the detector's
+    // targetDetected/detectionComplete). Off by default: displays should
+    // poll the getters above instead of queueing an event per frame.
+    void setFrameSignalsEnabled(bool enabled);
+    bool isFrameSignalsEnabled() const;
 
 signals:
     void started();
@@ -50,6 +105,7 @@ signals:
     void targetFound(const QPoint& position);
     void assistApplied(const QPoint& from, const QPoint& to);
     void statsUpdated(double fps, int targets, int assists);
+    void pipelineStatsUpdated(const PipelineStats& stats);
 
 private slots:
     void onTrackerTick();
@@ -59,6 +115,12 @@ private:
     std::unique_ptr<ScreenCapture> m_screenCapture;
     std::unique_ptr<ColorDetection> m_colorDetection;
     std::unique_ptr<MouseController> m_mouseController;
+    std::unique_ptr<FrameRecorder> m_frameRecorder;
+    std::unique_ptr<AdaptiveGovernor> m_governor;
+    std::unique_ptr<TargetFeed> m_targetFeed;
+    std::unique_ptr<MetricsRegistry> m_metrics;
+    std::unique_ptr<SettingsStore> m_settings;
+    std::map<QString, DetectionSettings> m_profiles;
 
     QTimer* m_trackerTimer;
     QTimer* m_statsTimer;
@@ -68,6 +130,10 @@ private:
     bool m_isRunning;
     bool m_isEnabled;
     int m_targetFPS;
+    bool m_feedHasTargets;
+    bool m_roiCaptureEnabled;
+    bool m_frameSignalsEnabled;
+    quint64 m_settingsVersion;
 
     // Stats
     double m_currentFPS;
@@ -75,8 +141,34 @@ private:
     int m_totalTargetsDetected;
     int m_totalAssists;
     qint64 m_totalRunningTime;
+    int m_maxFrameAgeMs;
+    int m_staleFramesDropped;
+    int m_staleDetectionsDropped;
+    PipelineStats m_pipelineStats;
+
+    // Per-interval stage timing
+    int m_intervalFrames;
+    double m_intervalCaptureMs;
+    double m_intervalDetectMs;
+    double m_intervalFrameCostMs;
+    double m_intervalMaxFrameCostMs;
+
+    // Rolling per-frame latency samples
+    LatencyWindow m_captureLatency;
+    LatencyWindow m_detectLatency;
+    LatencyWindow m_frameLatency;
+    quint64 m_lastBufferAllocations;
 
     void processFrame();
+    void applySettings(const DetectionSettings& settings);
+    void fillLiveStats(PipelineStats& stats) const;
+    cv::Mat captureFrame();
+    void applyFrameInterval(int fps);
+    bool isStale(qint64 captureTimestampNs) const;
+    void publishTargets(const std::vector<DetectedTarget>& targets, const QPoint& selected,
+                        const CoordinateTransform& transform, qint64 timestampNs);
+    void recordFrame(const cv::Mat& frame, qint64 timestampNs);
+    QByteArray createConfigSnapshot() const;
     DetectedTarget selectBestTarget(const std::vector<DetectedTarget>& targets);
 };
 
@@ -7,14 +7,17 @@
 #include <QPushButton>
 #include <QSlider>
 #include <QLineEdit>
+#include <QComboBox>
 #include <QTabWidget>
 #include <QListWidget>
 #include <QListWidgetItem>
-#include <QTimer>
 #include <QWidget>
 #include <QString>
 #include <vector>
 
+class PixelSampler;
+class ScreenCapture;
+
 struct ColorFormat {
     QString name;
     QString value;
@@ -24,7 +27,8 @@ class AdvancedColorPicker : public QDialog {
     Q_OBJECT
 
 public:
-    explicit AdvancedColorPicker(QWidget* parent = nullptr);
+    // Screen picking shares capture if given one (e.g. the tracker's)
+    explicit AdvancedColorPicker(QWidget* parent = nullptr, ScreenCapture* capture = nullptr);
     ~AdvancedColorPicker();
 
     QColor getSelectedColor() const;
@@ -41,7 +45,7 @@ private slots:
     void onCMYKChanged();
     void onHexChanged();
     void onHistoryItemClicked(QListWidgetItem* item);
-    void onPickerTimer();
+    void onPixelSampled();
     void onOkClicked();
     void onCancelClicked();
 
@@ -100,10 +104,11 @@ private:
 
     // Buttons
     QPushButton* m_pickButton;
+    QComboBox* m_sampleSizeCombo;
     QPushButton* m_okButton;
     QPushButton* m_cancelButton;
 
-    QTimer* m_pickerTimer;
+    PixelSampler* m_sampler;
     QTabWidget* m_tabWidget;
 
     void setupUI();
@@ -122,7 +127,8 @@ private:
     void addToHistory(const QColor& color);
     void loadHistory();
     void saveHistory();
-    QColor getColorAtCursor();
+    void stopPicking();
+    void updateMagnifier();
     QString colorToAllFormats(const QColor& color);
 };
 
@@ -7,14 +7,17 @@
 #include <QPushButton>
 #include <QSlider>
 #include <QLineEdit>
-#include <QTimer>
 #include <QWidget>
 
+class PixelSampler;
+class ScreenCapture;
+
 class ColorPicker : public QDialog {
     Q_OBJECT
 
 public:
-    explicit ColorPicker(QWidget* parent = nullptr);
+    // Screen picking shares capture if given one (e.g. the tracker's)
+    explicit ColorPicker(QWidget* parent = nullptr, ScreenCapture* capture = nullptr);
     ~ColorPicker();
 
     QColor getSelectedColor() const;
@@ -28,7 +31,7 @@ private slots:
     void onPickFromScreenClicked();
     void onRGBChanged();
     void onHexChanged();
-    void onPickerTimer();
+    void onPixelSampled();
     void onOkClicked();
     void onCancelClicked();
 
@@ -54,13 +57,13 @@ private:
     QPushButton* m_okButton;
     QPushButton* m_cancelButton;
 
-    QTimer* m_pickerTimer;
+    PixelSampler* m_sampler;
 
     void setupUI();
     void updatePreview();
     void updateSliders();
     void updateEdits();
-    QColor getColorAtCursor();
+    void stopPicking();
 };
 
 #endif // COLORPICKER_H
@@ -17,16 +17,24 @@
 #include <QCloseEvent>
 #include <QColor>
 #include <QString>
+#include <QJsonObject>
+#include <QTimer>
 #include <memory>
 
 #include "core/Tracker.h"
 #include "core/Overlay.h"
+#include "core/ColorCalibrator.h"
 #include "utils/ConfigManager.h"
 #include "utils/TranslationManager.h"
 #include "utils/StatsTracker.h"
+#include "utils/MetricsServer.h"
+#include "ui/SparklineWidget.h"
+#include "ui/Retranslator.h"
+#include "ui/StatsModel.h"
 
 class ColorPicker;
 class AdvancedColorPicker;
+class PixelSampler;
 class SettingsPanel;
 class StatsPanel;
 
@@ -53,14 +61,24 @@ private slots:
     void onColorSelected(const QColor& color);
     void onToleranceChanged(int value);
 
+    // Colour calibration
+    void onCalibrateClicked();
+    void onCalibrationSampled();
+    void finishCalibration();
+
     // Monitor slots
     void onMonitorChanged(int index);
 
     // Language slots
     void onLanguageChanged(int index);
 
+    // Config file edited by another process
+    void onConfigReloaded(const QStringList& changedKeys);
+
     // Stats slots
-    void onStatsUpdated(double fps, int targets, int assists);
+    void onStatsModelUpdated(const StatsSnapshot& stats, int changedFields);
+    void onPipelineStatsUpdated(const PipelineStats& stats);
+    void onRollupRecorded(const MetricsRollup& rollup);
 
     // Tray slots
     void onTrayActivated(QSystemTrayIcon::ActivationReason reason);
@@ -77,6 +95,9 @@ private:
     std::unique_ptr<ConfigManager> m_configManager;
     std::unique_ptr<TranslationManager> m_translationManager;
     std::unique_ptr<StatsTracker> m_statsTracker;
+    std::unique_ptr<MetricsServer> m_metricsServer;
+    std::unique_ptr<Retranslator> m_retranslator;
+    std::unique_ptr<StatsModel> m_statsModel;
 
     // UI Components
     QWidget* m_centralWidget;
@@ -86,6 +107,8 @@ private:
     QPushButton* m_startStopButton;
     QLabel* m_statusLabel;
     QLabel* m_fpsLabel;
+    QLabel* m_governorLabel;
+    SparklineWidget* m_fpsSparkline;
 
     // Detection tab
     QSlider* m_aimAssistSlider;
@@ -98,15 +121,30 @@ private:
     QLabel* m_selectedColorLabel;
     QSlider* m_toleranceSlider;
     QLabel* m_toleranceLabel;
+    QPushButton* m_calibrateButton;
+    QPushButton* m_clearCalibrationButton;
+    QLabel* m_calibrationLabel;
+    QCheckBox* m_backProjectionCheckbox;
+    QCheckBox* m_adaptiveFPSCheckbox;
+    QSlider* m_latencyBudgetSlider;
+    QLabel* m_latencyBudgetLabel;
+    QSlider* m_maxFrameAgeSlider;
+    QLabel* m_maxFrameAgeLabel;
 
     // Visual tab
     QCheckBox* m_overlayCheckbox;
     QCheckBox* m_fovCircleCheckbox;
     QCheckBox* m_crosshairCheckbox;
+    QCheckBox* m_hudCheckbox;
     QComboBox* m_monitorCombo;
 
     // Settings tab
+    QComboBox* m_profileCombo;
+    QPushButton* m_saveProfileButton;
+    QPushButton* m_deleteProfileButton;
     QComboBox* m_languageCombo;
+    QCheckBox* m_recordCheckbox;
+    QCheckBox* m_metricsCheckbox;
 
     // Stats display
     QLabel* m_targetsLabel;
@@ -121,9 +159,22 @@ private:
     ColorPicker* m_colorPicker;
     AdvancedColorPicker* m_advancedColorPicker;
 
+    // Colour calibration: target pixels under the cursor, background from
+    // the ring around them
+    PixelSampler* m_calibrationSampler;
+    QTimer* m_calibrationTimer;
+    ColorCalibrator m_colorCalibrator;
+    cv::Mat m_calibrationBackgroundMask;
+    ColorCalibration m_lastCalibration;
+    bool m_calibrationFailed;
+
     // State
     bool m_isRunning;
+    bool m_applyingConfig;      // Inside onConfigReloaded; suppresses autosave
     QColor m_selectedColor;
+    CalibratedColorRange m_calibratedRange;
+    std::shared_ptr<const HueSatModel> m_hueSatModel;
+    PipelineStats m_lastPipelineStats;
 
     // Setup methods
     void setupUI();
@@ -135,14 +186,28 @@ private:
     void setupTrayIcon();
     void setupConnections();
     void setupHotkeys();
+    void setupAutoSave();
 
     // Helper methods
     void applyDarkTheme();
     void loadSettings();
     void saveSettings();
     void updateUILanguage();
+    void applyCalibration(const CalibratedColorRange& range, const std::shared_ptr<const HueSatModel>& model);
+    void updateCalibrationLabel();
+    void updateMaxFrameAgeLabel();
+    void updateGovernorLabel();
+    void updateSparklineToolTip();
+    void refreshProfiles();
+    void switchProfile(const QString& name);
+    void cycleProfile();
+    DetectionSettings settingsForProfile(const QJsonObject& profile) const;
     void updateStatus(const QString& status);
-    QGroupBox* createGroupBox(const QString& title);
+    QString createRecordingPath() const;
+    QGroupBox* createGroupBox(TrKey title, const QString& format);
+    QLabel* createLabel(TrKey key, const QString& format = "%1:");
+    QString translate(TrKey key) const;
+    QString monitorText(const MonitorInfo& monitor) const;
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,71 @@
+#ifndef RETRANSLATOR_H
+#define RETRANSLATOR_H
+
+#include <QString>
+#include <QtGlobal>
+#include <functional>
+#include <vector>
+
+#include "utils/TranslationManager.h"
+
+class QWidget;
+class QLabel;
+class QAbstractButton;
+class QGroupBox;
+class QTabWidget;
+class QAction;
+
+// Keeps every translatable piece of text in a window together with its
+// TrKey and applies a language in one batch: painting is suspended, all
+// texts and the layout direction change, pending relayouts are processed
+// once and the window repaints once when updates resume. Registered
+// objects must outlive the Retranslator (children of the same window).
+class Retranslator {
+public:
+    explicit Retranslator(const TranslationManager* translations);
+
+    // format receives the translation as %1, e.g. "🏠 %1" or "%1:"
+    void addText(QLabel* label, TrKey key, const QString& format = "%1");
+    void addText(QAbstractButton* button, TrKey key, const QString& format = "%1");
+    void addTitle(QGroupBox* group, TrKey key, const QString& format = "%1");
+    void addTab(QTabWidget* tabs, int index, TrKey key, const QString& format = "%1");
+    void addAction(QAction* action, TrKey key, const QString& format = "%1");
+    void addWindowTitle(QWidget* window, TrKey key, const QString& format = "%1");
+
+    // For text built from several keys or live values
+    void addCallback(std::function<void()> callback);
+
+    // Applies the current language to everything registered and returns
+    // the time taken, relayout included, in microseconds
+    qint64 apply(QWidget* root);
+
+    qint64 getLastApplyUs() const;
+    int count() const;
+
+private:
+    enum class Kind {
+        Label,
+        Button,
+        GroupTitle,
+        Tab,
+        Action,
+        WindowTitle
+    };
+
+    struct Entry {
+        Kind kind;
+        void* target;
+        int index;
+        TrKey key;
+        QString format;
+    };
+
+    const TranslationManager* m_translations;
+    std::vector<Entry> m_entries;
+    std::vector<std::function<void()>> m_callbacks;
+    qint64 m_lastApplyUs;
+
+    void add(Kind kind, void* target, int index, TrKey key, const QString& format);
+};
+
+#endif // RETRANSLATOR_H
@@ -0,0 +1,47 @@
+#ifndef SPARKLINEWIDGET_H
+#define SPARKLINEWIDGET_H
+
+#include <QWidget>
+#include <QColor>
+#include <QPolygonF>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <vector>
+
+// Minimal line chart for a short metric history. The polyline is rebuilt
+// when values or size change, so repaints only stroke a cached path.
+class SparklineWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit SparklineWidget(QWidget* parent = nullptr);
+    ~SparklineWidget();
+
+    void setValues(const std::vector<double>& values);
+    void setCapacity(int points);
+    int getCapacity() const;
+
+    // Dashed horizontal guide (e.g. target FPS); <= 0 hides it
+    void setReferenceValue(double value);
+
+    void setLineColor(const QColor& color);
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+private:
+    std::vector<double> m_values;
+    int m_capacity;
+    double m_referenceValue;
+    QColor m_lineColor;
+
+    QPolygonF m_polyline;
+    double m_scaleMax;
+
+    void rebuildPolyline();
+};
+
+#endif // SPARKLINEWIDGET_H
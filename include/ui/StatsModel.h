@@ -0,0 +1,55 @@
+#ifndef STATSMODEL_H
+#define STATSMODEL_H
+
+#include <QObject>
+#include <QTimer>
+#include <QtGlobal>
+
+class Tracker;
+
+// What the stats labels show, already rounded to display precision so an
+// unchanged label compares equal
+struct StatsSnapshot {
+    int fps = 0;
+    int targets = 0;
+    int assists = 0;
+    qint64 runTimeSeconds = 0;
+};
+
+// Coalesces the tracker's counters for display. Polls at a fixed low rate
+// (4 Hz by default) while the tracker runs, once more when it stops, and
+// reports only the fields that changed, so the UI sees at most a few cheap
+// updates per second however many frames go by.
+class StatsModel : public QObject {
+    Q_OBJECT
+
+public:
+    enum Field {
+        FPS = 0x1,
+        Targets = 0x2,
+        Assists = 0x4,
+        RunTime = 0x8,
+        AllFields = FPS | Targets | Assists | RunTime
+    };
+
+    explicit StatsModel(const Tracker* tracker, QObject* parent = nullptr);
+    ~StatsModel();
+
+    void setInterval(int intervalMs);
+    int getInterval() const;
+
+    const StatsSnapshot& getSnapshot() const;
+
+    // Polls now; emits updated() if anything changed and returns the mask
+    int refresh();
+
+signals:
+    void updated(const StatsSnapshot& snapshot, int changedFields);
+
+private:
+    const Tracker* m_tracker;
+    QTimer* m_pollTimer;
+    StatsSnapshot m_snapshot;
+};
+
+#endif // STATSMODEL_H
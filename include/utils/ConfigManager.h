@@ -6,8 +6,15 @@
 #include <QColor>
 #include <QVariant>
 #include <QJsonObject>
+#include <QJsonValue>
 #include <QByteArray>
+#include <QStringList>
+#include <QFileSystemWatcher>
+#include <QThread>
+#include <QTimer>
+#include <atomic>
 #include <map>
+#include "core/SettingsStore.h"
 
 class ConfigManager : public QObject {
     Q_OBJECT
@@ -16,11 +23,22 @@ public:
     explicit ConfigManager(QObject* parent = nullptr);
     ~ConfigManager();
 
-    // Load/Save
+    // Load/Save. Writes happen on a background I/O thread: the config is
+    // serialised there and replaced atomically (temp file + rename), and a
+    // write superseded by a newer one before it starts is skipped.
     bool load();
-    bool save();
+    bool save();            // Queue a write of the current config now
+    void scheduleSave();    // Queue one after changes settle (debounced)
+    bool flush();           // Write pending changes and wait; false if the last write failed
     void reset();
 
+    // Hot reload: edits made to the config file by other processes are
+    // read and parsed on the I/O thread, diffed against the live config,
+    // and only the keys that changed are applied (see configReloaded).
+    // Our own writes are recognised and ignored.
+    void setHotReloadEnabled(bool enabled);
+    bool isHotReloadEnabled() const;
+
     // Generic getters/setters
     QVariant getValue(const QString& key, const QVariant& defaultValue = QVariant()) const;
     void setValue(const QString& key, const QVariant& value);
@@ -41,6 +59,30 @@ public:
     int getColorTolerance() const;
     void setColorTolerance(int value);
 
+    // Stored as [lowH, lowS, lowV, highH, highS, highV]; [] when uncalibrated
+    CalibratedColorRange getCalibratedRange() const;
+    void setCalibratedRange(const CalibratedColorRange& range);
+    static CalibratedColorRange parseCalibratedRange(const QJsonValue& value);
+
+    // Stored as {"cells": base64 bitmap, "value": [low, high]}; {} when
+    // uncalibrated. Returns null without a model.
+    std::shared_ptr<const HueSatModel> getHueSatModel() const;
+    void setHueSatModel(const std::shared_ptr<const HueSatModel>& model);
+    static std::shared_ptr<const HueSatModel> parseHueSatModel(const QJsonValue& value);
+
+    bool isBackProjectionEnabled() const;
+    void setBackProjectionEnabled(bool enabled);
+
+    // Performance settings
+    bool isAdaptiveFPSEnabled() const;
+    void setAdaptiveFPSEnabled(bool enabled);
+
+    double getLatencyBudget() const;
+    void setLatencyBudget(double budgetMs);
+
+    int getMaxFrameAge() const;
+    void setMaxFrameAge(int ageMs);
+
     // Visual settings
     bool isOverlayEnabled() const;
     void setOverlayEnabled(bool enabled);
@@ -51,6 +93,14 @@ public:
     bool isCrosshairVisible() const;
     void setCrosshairVisible(bool visible);
 
+    bool isHUDVisible() const;
+    void setHUDVisible(bool visible);
+
+    // No UI control; turn off in the config file to compare
+    // agar_overlay_paint_ms against live-stroked FOV and crosshair
+    bool isOverlayLayerCachingEnabled() const;
+    void setOverlayLayerCachingEnabled(bool enabled);
+
     // General settings
     QString getLanguage() const;
     void setLanguage(const QString& language);
@@ -64,10 +114,35 @@ public:
     bool isStartMinimized() const;
     void setStartMinimized(bool minimized);
 
+    // Recording settings
+    bool isRecordingEnabled() const;
+    void setRecordingEnabled(bool enabled);
+
+    // Metrics endpoint (localhost only)
+    bool isMetricsEndpointEnabled() const;
+    void setMetricsEndpointEnabled(bool enabled);
+
+    int getMetricsPort() const;
+    void setMetricsPort(int port);
+
+    // Per-game profiles: named copies of the keys in getProfileKeys(),
+    // stored under "profiles"
+    static const QStringList& getProfileKeys();
+    QStringList getProfileNames() const;
+    QJsonObject getProfile(const QString& name) const;
+    QString getActiveProfile() const;
+
+    void saveProfile(const QString& name);      // Current values become the profile
+    bool applyProfile(const QString& name);     // Profile values become current; emits configReloaded
+    void deleteProfile(const QString& name);
+
     // Hotkeys
     QString getToggleHotkey() const;
     void setToggleHotkey(const QString& hotkey);
 
+    QString getProfileHotkey() const;
+    void setProfileHotkey(const QString& hotkey);
+
     // Encryption
     void setEncryptionEnabled(bool enabled);
     bool isEncryptionEnabled() const;
@@ -75,7 +150,9 @@ public:
 signals:
     void configLoaded();
     void configSaved();
+    void saveFailed(const QString& error);
     void settingChanged(const QString& key, const QVariant& value);
+    void configReloaded(const QStringList& changedKeys);
 
 private:
     QString m_configPath;
@@ -83,7 +160,27 @@ private:
     bool m_encryptionEnabled;
     QString m_encryptionKey;
 
+    // Background persistence
+    bool m_dirty;
+    QTimer* m_saveTimer;
+    QThread m_ioThread;
+    QObject* m_ioContext;                   // Lives on m_ioThread
+    std::atomic<quint64> m_saveGeneration;  // Of the newest queued write
+    std::atomic<bool> m_lastSaveOk;
+    QByteArray m_lastWrittenHash;           // I/O thread only
+
+    // Hot reload
+    QFileSystemWatcher* m_watcher;
+    QTimer* m_reloadTimer;
+    bool m_hotReloadEnabled;
+
     QString getConfigFilePath() const;
+    void queueWrite();
+    bool writeConfig(const QJsonObject& config, bool encrypted, QString& error);
+    void updateWatchedPaths();
+    void queueReload();
+    QStringList applyChangedKeys(const QJsonObject& values);
+    void applyReloadedConfig(const QJsonObject& config);
     QString encrypt(const QString& data) const;
     QString decrypt(const QString& data) const;
     void setDefaults();
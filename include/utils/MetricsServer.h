@@ -0,0 +1,43 @@
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include <QObject>
+#include <QThread>
+#include <QString>
+#include <QtGlobal>
+
+class QTcpServer;
+class MetricsRegistry;
+
+// Opt-in HTTP endpoint serving GET /metrics in Prometheus text format.
+// Listens on 127.0.0.1 only and runs its socket handling on a dedicated
+// thread, reading the lock-free MetricsRegistry directly; the UI thread
+// and the pipeline are never involved in a scrape.
+class MetricsServer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit MetricsServer(MetricsRegistry* registry, QObject* parent = nullptr);
+    ~MetricsServer();
+
+    bool start(quint16 port);
+    void stop();
+    bool isRunning() const;
+    quint16 getPort() const;
+    QString getErrorString() const;
+
+signals:
+    void serverError(const QString& error);
+
+private:
+    MetricsRegistry* m_registry;
+    QThread m_thread;
+    QObject* m_context;     // Lives on m_thread; owns the server
+    QTcpServer* m_server;
+    quint16 m_port;
+    QString m_errorString;
+
+    void handleConnection();
+};
+
+#endif // METRICSSERVER_H
@@ -0,0 +1,77 @@
+#ifndef SESSIONLOG_H
+#define SESSIONLOG_H
+
+#include <QString>
+#include <QFile>
+#include <QByteArray>
+#include <QtGlobal>
+#include <vector>
+
+// Append-only binary log of typed, checksummed records:
+//
+//   "AGASLOG1" | version
+//   { RecordHeader | payload } ...
+//
+// Writing a record appends it; nothing is ever rewritten in place. Opening
+// the log scans only record headers into an in-memory index (payloads are
+// skipped with a seek), so startup cost is independent of payload size. A
+// torn record left by a crash is detected by its checksum and truncated.
+// compact() rewrites the file keeping the latest totals, every session and
+// only recent rollups and resource snapshots.
+class SessionLog {
+public:
+    enum class RecordType : quint16 {
+        Totals = 1,     // Lifetime counters; only the latest matters
+        Session = 2,    // One finished session
+        Rollups = 3,    // A batch of per-second metric rollups
+        Resources = 4   // Process and per-thread resource usage snapshot
+    };
+
+    struct Record {
+        RecordType type;
+        qint64 timestampMs;
+        QByteArray payload;
+    };
+
+    explicit SessionLog(const QString& filePath);
+    ~SessionLog();
+
+    bool open();
+    void close();
+    bool isOpen() const;
+
+    bool append(RecordType type, qint64 timestampMs, const QByteArray& payload);
+
+    // Records of one type with fromMs <= timestamp < toMs, in append order.
+    // Records are expected to be appended in time order.
+    std::vector<Record> query(RecordType type, qint64 fromMs, qint64 toMs) const;
+    bool readLatest(RecordType type, Record& record) const;
+
+    // Rewrite the log without superseded totals, and without rollups and
+    // resource snapshots older than the retention window
+    bool compact(qint64 rollupRetentionMs);
+
+    qint64 getFileSize() const;
+    int getRecordCount() const;
+    QString getFilePath() const;
+    QString getErrorString() const;
+
+private:
+    struct IndexEntry {
+        qint64 timestampMs;
+        qint64 offset;          // Of the payload
+        quint32 payloadSize;
+        quint32 checksum;
+        RecordType type;
+    };
+
+    QString m_filePath;
+    mutable QFile m_file;
+    std::vector<IndexEntry> m_index;
+    QString m_errorString;
+
+    bool scan();
+    bool readPayload(const IndexEntry& entry, QByteArray& payload) const;
+};
+
+#endif // SESSIONLOG_H
@@ -6,6 +6,12 @@
 #include <QDateTime>
 #include <QJsonObject>
 #include <QElapsedTimer>
+#include <QByteArray>
+#include <vector>
+#include <memory>
+#include "core/PipelineStats.h"
+#include "core/ResourceMonitor.h"
+#include "utils/SessionLog.h"
 
 struct SessionStats {
     qint64 startTime;
@@ -16,6 +22,33 @@ struct SessionStats {
     int peakFPS;
 };
 
+// One second of pipeline history. Plain 4-byte fields, no padding, so the
+// ring can be exported as-is.
+struct MetricsRollup {
+    quint32 second;             // Seconds since session start
+    float fps;
+    float captureP50Ms;
+    float captureP95Ms;
+    float detectP50Ms;
+    float detectP95Ms;
+    float frameP50Ms;
+    float frameP95Ms;
+    float frameP99Ms;
+    quint32 targets;            // Targets detected during this second
+    quint32 drops;              // Stale frames + detections dropped during this second
+    float cpuTimeMs;            // Process CPU time used during this second
+    quint32 residentKb;         // Process RSS / working set at the end of the second
+    quint32 voluntarySwitches;  // Context switches during this second
+    quint32 involuntarySwitches;
+    quint32 pageFaults;         // Minor + major faults during this second
+};
+
+// Rollups as persisted: one batch per log record
+struct RollupBatch {
+    qint64 sessionStartMs;
+    std::vector<MetricsRollup> rollups;
+};
+
 class StatsTracker : public QObject {
     Q_OBJECT
 
@@ -33,6 +66,25 @@ public:
     void recordAssistApplied();
     void recordFPS(double fps);
 
+    // Per-second history: samples process resources and appends one rollup
+    // (O(1), no allocation) into a ring sized at session start. Also feeds
+    // recordFPS.
+    void recordPipelineStats(const PipelineStats& stats);
+
+    void setRollupCapacity(int seconds);
+    int getRollupCapacity() const;
+    int getRollupCount() const;
+
+    // Most recent rollups, oldest first
+    std::vector<MetricsRollup> getRecentRollups(int count) const;
+
+    // Resource usage taken with the latest rollup, including per-thread CPU
+    const ResourceSample& getLastResourceSample() const;
+
+    // Compact binary export: "AGAROLL1", version, record size, count, records
+    QByteArray exportRollups() const;
+    bool exportRollups(const QString& filePath) const;
+
     // Current session stats
     int getSessionTargets() const;
     int getSessionAssists() const;
@@ -50,15 +102,21 @@ public:
     QString getFormattedTotalTime() const;
     QString getStatsReport() const;
 
-    // Persistence
+    // Persistence (append-only session log; see SessionLog)
     bool loadStats();
     bool saveStats();
     void resetStats();
 
+    // History from the session log, fromMs <= time < toMs (epoch ms)
+    std::vector<SessionStats> getSessionHistory(qint64 fromMs, qint64 toMs) const;
+    std::vector<RollupBatch> getRollupHistory(qint64 fromMs, qint64 toMs) const;
+    std::vector<ResourceSample> getResourceHistory(qint64 fromMs, qint64 toMs) const;
+
 signals:
     void statsUpdated();
     void sessionStarted();
     void sessionEnded(const SessionStats& stats);
+    void rollupRecorded(const MetricsRollup& rollup);
 
 private:
     // Current session
@@ -70,6 +128,27 @@ private:
     int m_sessionFPSCount;
     int m_sessionPeakFPS;
 
+    qint64 m_sessionStartMs;
+
+    // Per-second rollup ring
+    std::vector<MetricsRollup> m_rollups;
+    int m_rollupCapacity;
+    int m_rollupNext;
+    int m_rollupCount;
+    int m_lastTotalTargets;
+    int m_lastTotalDrops;
+
+    // Cumulative OS counters as of the previous rollup
+    ResourceMonitor m_resourceMonitor;
+    qint64 m_lastCpuTimeUs;
+    quint64 m_lastVoluntarySwitches;
+    quint64 m_lastInvoluntarySwitches;
+    quint64 m_lastPageFaults;
+
+    // Rollups not yet written to the log (flushed every minute)
+    std::unique_ptr<SessionLog> m_sessionLog;
+    std::vector<MetricsRollup> m_pendingRollups;
+
     // Lifetime stats
     int m_totalTargets;
     int m_totalAssists;
@@ -77,6 +156,10 @@ private:
     int m_totalSessions;
 
     QString getStatsFilePath() const;
+    QString getLegacyStatsFilePath() const;
+    bool loadLegacyStats();
+    void flushRollups();
+    void resetResourceBaseline();
     QString formatDuration(qint64 ms) const;
 };
 
@@ -1,11 +1,12 @@
 #ifndef TRANSLATIONMANAGER_H
 #define TRANSLATIONMANAGER_H
 
+#include "utils/TranslationTable.h"
 #include <QObject>
 #include <QString>
 #include <QStringList>
 #include <QMap>
-#include <QJsonObject>
+#include <array>
 
 class TranslationManager : public QObject {
     Q_OBJECT
@@ -20,9 +21,12 @@ public:
     QStringList getAvailableLanguages() const;
     QString getLanguageName(const QString& code) const;
 
-    // Translation
+    // Translation. The TrKey overloads are a plain array index; the string
+    // overloads hash the key once and return it unchanged if it is unknown.
+    QString translate(TrKey key) const;
     QString translate(const QString& key) const;
-    QString tr(const QString& key) const; // Alias for translate
+    QString tr(TrKey key) const { return translate(key); }
+    QString tr(const QString& key) const { return translate(key); }
 
     // Check if RTL
     bool isRTL() const;
@@ -31,15 +35,18 @@ signals:
     void languageChanged(const QString& languageCode);
 
 private:
+    using StringTable = std::array<QString, TranslationTable::kKeyCount>;
+
     QString m_currentLanguage;
-    QJsonObject m_translations;
+    StringTable m_english;
+    StringTable m_arabic;
+    const StringTable* m_strings;   // Table of the current language
     QMap<QString, QString> m_languageNames;
     QStringList m_rtlLanguages;
 
-    void loadTranslations();
     void initLanguageNames();
-    QJsonObject getEnglishTranslations() const;
-    QJsonObject getArabicTranslations() const;
+    static void buildTable(StringTable& table, const TranslationTable::Strings& source);
+    const StringTable* tableForLanguage(const QString& languageCode) const;
 };
 
 #endif // TRANSLATIONMANAGER_H
@@ -0,0 +1,267 @@
+#ifndef TRANSLATIONTABLE_H
+#define TRANSLATIONTABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Every translatable string, one row each: id, lookup key, English, Arabic.
+// An empty translation falls back to English. Adding a row is all it takes;
+// the TrKey ids, the per-language tables and the perfect hash over the
+// lookup keys are all derived from this list at compile time.
+#define AGA_TRANSLATIONS(X) \
+    /* App */ \
+    X(AppTitle,       "app_title",        "Accessibility Gaming Assistant", u8"مساعد الألعاب للوصول") \
+    X(AppVersion,     "app_version",      "Version 1.0.0", u8"الإصدار 1.0.0") \
+    /* Main tab */ \
+    X(TabMain,        "tab_main",         "Main", u8"الرئيسية") \
+    X(TabDetection,   "tab_detection",    "Detection", u8"الكشف") \
+    X(TabVisual,      "tab_visual",       "Visual", u8"المرئيات") \
+    X(TabSettings,    "tab_settings",     "Settings", u8"الإعدادات") \
+    /* Controls */ \
+    X(ControlGroup,   "control_group",    "Control", u8"التحكم") \
+    X(ButtonStart,    "btn_start",        "Start", u8"تشغيل") \
+    X(ButtonStop,     "btn_stop",         "Stop", u8"إيقاف") \
+    X(StatusStopped,  "status_stopped",   "Status: Stopped", u8"الحالة: متوقف") \
+    X(StatusRunning,  "status_running",   "Status: Running", u8"الحالة: يعمل") \
+    /* Quick settings */ \
+    X(QuickSettings,  "quick_settings",   "Quick Settings", u8"إعدادات سريعة") \
+    X(AimAssist,      "aim_assist",       "Aim Assist", u8"مساعد التصويب") \
+    X(ResponseSpeed,  "response_speed",   "Response Speed", u8"سرعة الاستجابة") \
+    /* Color detection */ \
+    X(ColorDetection, "color_detection",  "Color Detection", u8"كشف الألوان") \
+    X(TargetColor,    "target_color",     "Target Color", u8"لون الهدف") \
+    X(SelectColor,    "select_color",     "Select Color", u8"اختر لون") \
+    X(Tolerance,      "tolerance",        "Tolerance", u8"التسامح") \
+    X(Calibrate,      "calibrate",        "Calibrate", u8"معايرة") \
+    X(Clear,          "clear",            "Clear", u8"مسح") \
+    X(Calibrating,    "calibrating",      "Keep the cursor on the target for %1 seconds...", u8"أبقِ المؤشر على الهدف لمدة %1 ثوانٍ...") \
+    X(Calibrated,     "calibrated",       "Calibrated", u8"تمت المعايرة") \
+    X(BackProjection, "back_projection",  "Match shades (back-projection)", u8"مطابقة الظلال (الإسقاط الخلفي)") \
+    X(CalibrationFailed, "calibration_failed", "Not enough target pixels, try again", u8"بكسلات الهدف غير كافية، حاول مرة أخرى") \
+    /* FOV */ \
+    X(FOVSettings,    "fov_settings",     "FOV Settings", u8"إعدادات مجال الرؤية") \
+    X(FOVRadius,      "fov_radius",       "FOV Radius", u8"نصف قطر مجال الرؤية") \
+    /* Performance */ \
+    X(Performance,    "performance",      "Performance", u8"الأداء") \
+    X(Off,            "off",              "Off", u8"إيقاف") \
+    X(AdaptiveFPS,    "adaptive_fps",     "Adaptive FPS (hold latency budget)", u8"معدل إطارات تكيفي (الالتزام بحد التأخير)") \
+    X(LatencyBudget,  "latency_budget",   "Latency Budget", u8"حد التأخير") \
+    X(MaxFrameAge,    "max_frame_age",    "Max Frame Age", u8"أقصى عمر للإطار") \
+    /* Overlay */ \
+    X(Overlay,        "overlay",          "Overlay", u8"الطبقة العلوية") \
+    X(EnableOverlay,  "enable_overlay",   "Enable Overlay", u8"تفعيل الطبقة العلوية") \
+    X(ShowFOVCircle,  "show_fov_circle",  "Show FOV Circle", u8"إظهار دائرة مجال الرؤية") \
+    X(ShowCrosshair,  "show_crosshair",   "Show Crosshair", u8"إظهار التقاطع") \
+    X(ShowHUD,        "show_hud",         "Show Performance HUD", u8"إظهار لوحة الأداء") \
+    /* Monitor */ \
+    X(Monitor,        "monitor",          "Monitor", u8"الشاشة") \
+    X(ActiveMonitor,  "active_monitor",   "Active Monitor", u8"الشاشة النشطة") \
+    X(Primary,        "primary",          "Primary", u8"الرئيسية") \
+    /* Language */ \
+    X(Language,       "language",         "Language", u8"اللغة") \
+    /* Profiles */ \
+    X(Profiles,       "profiles",         "Profiles", u8"الملفات الشخصية") \
+    X(Profile,        "profile",          "Profile", u8"الملف الشخصي") \
+    X(SaveProfileAs,  "save_profile_as",  "Save As...", u8"حفظ باسم...") \
+    X(Delete,         "delete",           "Delete", u8"حذف") \
+    X(ProfileHint,    "profile_hint",     "Saves detection, assist, FPS and capture settings. %1 cycles profiles.", u8"يحفظ إعدادات الكشف والمساعدة ومعدل الإطارات والالتقاط. %1 للتنقل بين الملفات.") \
+    /* Recording and metrics */ \
+    X(Recording,      "recording",        "Recording", u8"التسجيل") \
+    X(RecordFrames,   "record_frames",    "Record FOV frames while running", u8"تسجيل إطارات مجال الرؤية أثناء التشغيل") \
+    X(Metrics,        "metrics",          "Metrics", u8"المقاييس") \
+    X(ServeMetrics,   "serve_metrics",    "Serve Prometheus metrics at %1", u8"نشر مقاييس Prometheus على %1") \
+    /* Stats */ \
+    X(Statistics,     "statistics",       "Statistics", u8"الإحصائيات") \
+    X(Targets,        "targets",          "Targets", u8"الأهداف") \
+    X(Assists,        "assists",          "Assists", u8"المساعدات") \
+    X(Time,           "time",             "Time", u8"الوقت") \
+    X(FPS,            "fps",              "FPS", u8"الإطارات/ثانية") \
+    /* Diagnostics */ \
+    X(QualityFull,    "quality_full",     "Full", u8"كاملة") \
+    X(QualityNoMorphology, "quality_no_morphology", "No Morphology", u8"بدون معالجة شكلية") \
+    X(QualityHalf,    "quality_half",     "Half Res", u8"نصف الدقة") \
+    X(QualityQuarter, "quality_quarter",  "Quarter Res", u8"ربع الدقة") \
+    X(GovernorStatus, "governor_status",  "Quality: %1 | Cadence: %2/%3 FPS | Cost: %4ms", u8"الجودة: %1 | الإيقاع: %2/%3 إطار/ث | التكلفة: %4 مللي ث") \
+    X(QualityStatus,  "quality_status",   "Quality: %1 | Cost: %2ms", u8"الجودة: %1 | التكلفة: %2 مللي ث") \
+    X(StaleDropped,   "stale_dropped",    "Stale dropped: %1 frames, %2 detections", u8"المهملة لقدمها: %1 إطارات، %2 اكتشافات") \
+    X(FPSHistory,     "fps_history",      "FPS, last 2 minutes", u8"الإطارات/ثانية، آخر دقيقتين") \
+    X(RollupDetails,  "rollup_details",   "Frame p95: %1 ms | CPU: %2 ms/s\nRSS: %3 MB | Ctx switches: %4/%5 per s | Faults: %6 per s", u8"الإطار p95: %1 مللي ث | المعالج: %2 مللي ث/ث\nالذاكرة: %3 ميغابايت | تبديل السياق: %4/%5 في الثانية | أخطاء الصفحات: %6 في الثانية") \
+    X(CalibrationStats, "calibration_stats", "%1: target pixels kept %2% | background let in %3%", u8"%1: بكسلات الهدف المحفوظة %2% | الخلفية المقبولة %3%") \
+    X(HSVRange,       "hsv_range",        "HSV range", u8"نطاق HSV") \
+    X(BackProjectionShort, "back_projection_short", "Back-projection", u8"الإسقاط الخلفي") \
+    X(StatusProfile,  "status_profile",   "Status: Profile \"%1\"", u8"الحالة: الملف الشخصي \"%1\"") \
+    X(MetricsUnavailable, "metrics_unavailable", "Status: Metrics endpoint unavailable (%1)", u8"الحالة: نقطة المقاييس غير متاحة (%1)") \
+    X(SaveProfile,    "save_profile",     "Save Profile", u8"حفظ الملف الشخصي") \
+    X(ProfileName,    "profile_name",     "Profile name:", u8"اسم الملف الشخصي:") \
+    X(SaveFailed,     "save_failed",      "Status: Settings could not be saved (%1)", u8"الحالة: تعذر حفظ الإعدادات (%1)") \
+    X(SettingsNotSaved, "settings_not_saved", "Settings could not be saved. Changes from this session may be lost.", u8"تعذر حفظ الإعدادات. قد تضيع التغييرات التي أجريت في هذه الجلسة.") \
+    /* Overlay HUD */ \
+    X(HudFPS,         "hud_fps",          "FPS     %1 / %2 (gov %3)", u8"الإطارات %1 / %2 (المنظم %3)") \
+    X(HudCapture,     "hud_capture",      "Capture p50 %1  p95 %2 ms", u8"الالتقاط p50 %1  p95 %2 مللي ث") \
+    X(HudDetect,      "hud_detect",       "Detect  p50 %1  p95 %2 ms", u8"الكشف p50 %1  p95 %2 مللي ث") \
+    X(HudFrame,       "hud_frame",        "Frame   p50 %1  p95 %2  p99 %3", u8"الإطار p50 %1  p95 %2  p99 %3") \
+    X(HudDropped,     "hud_dropped",      "Dropped %1 frames, %2 detections", u8"المهملة %1 إطارات، %2 اكتشافات") \
+    X(HudTargets,     "hud_targets",      "Targets %1 on screen, %2 total", u8"الأهداف %1 على الشاشة، %2 إجمالاً") \
+    /* About */ \
+    X(About,          "about",            "About", u8"حول") \
+    X(AboutDesc,      "about_desc",       "Helping gamers with disabilities play better.", u8"مساعدة اللاعبين ذوي الإعاقات على اللعب بشكل أفضل.") \
+    /* Color picker */ \
+    X(ColorPicker,    "color_picker",     "Color Picker", u8"منتقي الألوان") \
+    X(PickFromScreen, "pick_from_screen", "Pick from Screen", u8"اختر من الشاشة") \
+    X(Current,        "current",          "Current", u8"الحالي") \
+    X(Original,       "original",         "Original", u8"الأصلي") \
+    X(History,        "history",          "History", u8"السجل") \
+    /* System tray */ \
+    X(ShowHide,       "show_hide",        "Show/Hide", u8"إظهار/إخفاء") \
+    X(Quit,           "quit",             "Quit", u8"خروج")
+
+enum class TrKey : std::uint16_t {
+#define AGA_TR_ID(id, key, en, ar) id,
+    AGA_TRANSLATIONS(AGA_TR_ID)
+#undef AGA_TR_ID
+    Count
+};
+
+namespace TranslationTable {
+
+constexpr std::size_t kKeyCount = static_cast<std::size_t>(TrKey::Count);
+using Strings = std::array<const char*, kKeyCount>;
+
+constexpr Strings kKeys = {{
+#define AGA_TR_KEY(id, key, en, ar) key,
+    AGA_TRANSLATIONS(AGA_TR_KEY)
+#undef AGA_TR_KEY
+}};
+
+constexpr Strings kEnglish = {{
+#define AGA_TR_EN(id, key, en, ar) en,
+    AGA_TRANSLATIONS(AGA_TR_EN)
+#undef AGA_TR_EN
+}};
+
+constexpr Strings kArabic = {{
+#define AGA_TR_AR(id, key, en, ar) ar,
+    AGA_TRANSLATIONS(AGA_TR_AR)
+#undef AGA_TR_AR
+}};
+
+// Seeded FNV-1a over code units, so UTF-16 QString data and the ASCII keys
+// above hash identically
+template<typename Char>
+constexpr std::uint32_t hashKey(const Char* key, std::size_t length, std::uint32_t seed) {
+    std::uint32_t hash = 2166136261u ^ seed;
+    for (std::size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<std::uint16_t>(key[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+constexpr std::size_t keyLength(const char* key) {
+    std::size_t length = 0;
+    while (key[length] != '\0') {
+        ++length;
+    }
+    return length;
+}
+
+// Hash-and-displace: a first hash spreads the keys over small buckets, and
+// each bucket gets the first seed that sends all of its keys to free slots.
+// Unlike a single global seed this keeps finding a solution as keys are added.
+constexpr std::size_t kBucketCount = kKeyCount / 2 + 1;
+constexpr std::size_t kSlotCount = kKeyCount * 2;
+constexpr std::uint16_t kEmptySlot = 0xFFFF;
+static_assert(kKeyCount < kEmptySlot, "Too many translation keys");
+
+struct PerfectHash {
+    bool complete;
+    std::array<std::uint16_t, kBucketCount> seeds;  // Second-level seed per bucket
+    std::array<std::uint16_t, kSlotCount> slots;    // Key index, or kEmptySlot
+};
+
+constexpr PerfectHash buildPerfectHash() {
+    PerfectHash result{true, {}, {}};
+    for (auto& slot : result.slots) {
+        slot = kEmptySlot;
+    }
+
+    // Computed once; compilers cap the work a constant expression may do
+    std::array<std::size_t, kKeyCount> lengths{};
+    std::array<std::size_t, kKeyCount> buckets{};
+    std::array<std::size_t, kBucketCount> bucketSizes{};
+    std::size_t largestBucket = 0;
+    for (std::size_t i = 0; i < kKeyCount; ++i) {
+        lengths[i] = keyLength(kKeys[i]);
+        buckets[i] = hashKey(kKeys[i], lengths[i], 0) % kBucketCount;
+        std::size_t size = ++bucketSizes[buckets[i]];
+        largestBucket = size > largestBucket ? size : largestBucket;
+    }
+
+    // Largest buckets first, while the table is still mostly empty
+    for (std::size_t size = largestBucket; size > 0; --size) {
+        for (std::size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+            if (bucketSizes[bucket] != size) {
+                continue;
+            }
+
+            bool placed = false;
+            for (std::uint32_t seed = 1; seed < kEmptySlot && !placed; ++seed) {
+                std::array<std::uint16_t, kSlotCount> slots = result.slots;
+                bool collision = false;
+                for (std::size_t i = 0; i < kKeyCount && !collision; ++i) {
+                    if (buckets[i] != bucket) {
+                        continue;
+                    }
+                    std::size_t slot = hashKey(kKeys[i], lengths[i], seed) % kSlotCount;
+                    if (slots[slot] != kEmptySlot) {
+                        collision = true;
+                    } else {
+                        slots[slot] = static_cast<std::uint16_t>(i);
+                    }
+                }
+
+                if (!collision) {
+                    result.slots = slots;
+                    result.seeds[bucket] = static_cast<std::uint16_t>(seed);
+                    placed = true;
+                }
+            }
+
+            if (!placed) {
+                result.complete = false;
+                return result;
+            }
+        }
+    }
+    return result;
+}
+
+constexpr PerfectHash kPerfectHash = buildPerfectHash();
+static_assert(kPerfectHash.complete, "No collision-free placement for the translation keys");
+
+// Index of a lookup key, or -1: two hashes and one comparison
+template<typename Char>
+constexpr int findKey(const Char* key, std::size_t length) {
+    std::uint16_t seed = kPerfectHash.seeds[hashKey(key, length, 0) % kBucketCount];
+    std::uint16_t index = kPerfectHash.slots[hashKey(key, length, seed) % kSlotCount];
+    if (index == kEmptySlot) {
+        return -1;
+    }
+
+    const char* candidate = kKeys[index];
+    for (std::size_t i = 0; i < length; ++i) {
+        if (candidate[i] == '\0' || static_cast<std::uint16_t>(candidate[i]) != static_cast<std::uint16_t>(key[i])) {
+            return -1;
+        }
+    }
+    return candidate[length] == '\0' ? index : -1;
+}
+
+static_assert(findKey("app_title", 9) == static_cast<int>(TrKey::AppTitle), "Perfect hash lookup is broken");
+static_assert(findKey("quit", 4) == static_cast<int>(TrKey::Quit), "Perfect hash lookup is broken");
+static_assert(findKey("missing", 7) == -1, "Perfect hash lookup is broken");
+
+} // namespace TranslationTable
+
+#endif // TRANSLATIONTABLE_H
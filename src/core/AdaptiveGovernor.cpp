@@ -0,0 +1,183 @@
+#include "core/AdaptiveGovernor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Cost above this share of the frame period means the timer is about to back up
+constexpr double kCadenceHighWater = 0.8;
+// Cost below these shares counts as headroom for stepping back up
+constexpr double kBudgetLowWater = 0.5;
+constexpr double kCadenceLowWater = 0.5;
+// Consecutive headroom windows required before upgrading (hysteresis)
+constexpr int kHeadroomWindowsToUpgrade = 3;
+}
+
+AdaptiveGovernor::AdaptiveGovernor(QObject* parent)
+    : QObject(parent)
+    , m_enabled(true)
+    , m_latencyBudget(6.0)
+    , m_minFPS(30)
+    , m_maxFPS(144)
+    , m_evaluationWindow(30)
+    , m_currentFPS(144)
+    , m_quality(DetectionQuality::Full)
+    , m_averageCost(0.0)
+    , m_windowCostSum(0.0)
+    , m_windowFrames(0)
+    , m_headroomWindows(0)
+    , m_adjustmentCount(0)
+{
+}
+
+AdaptiveGovernor::~AdaptiveGovernor() {
+}
+
+void AdaptiveGovernor::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!enabled) {
+        reset();
+    }
+}
+
+bool AdaptiveGovernor::isEnabled() const {
+    return m_enabled;
+}
+
+void AdaptiveGovernor::setLatencyBudget(double budgetMs) {
+    m_latencyBudget = std::clamp(budgetMs, 1.0, 100.0);
+}
+
+double AdaptiveGovernor::getLatencyBudget() const {
+    return m_latencyBudget;
+}
+
+void AdaptiveGovernor::setFPSRange(int minFPS, int maxFPS) {
+    m_maxFPS = std::max(1, maxFPS);
+    m_minFPS = std::clamp(minFPS, 1, m_maxFPS);
+    m_currentFPS = std::clamp(m_currentFPS, m_minFPS, m_maxFPS);
+}
+
+int AdaptiveGovernor::getMinFPS() const {
+    return m_minFPS;
+}
+
+int AdaptiveGovernor::getMaxFPS() const {
+    return m_maxFPS;
+}
+
+void AdaptiveGovernor::setEvaluationWindow(int frames) {
+    m_evaluationWindow = std::clamp(frames, 1, 1000);
+}
+
+int AdaptiveGovernor::getEvaluationWindow() const {
+    return m_evaluationWindow;
+}
+
+void AdaptiveGovernor::reset() {
+    bool qualityChanged = m_quality != DetectionQuality::Full;
+    bool fpsChanged = m_currentFPS != m_maxFPS;
+
+    m_currentFPS = m_maxFPS;
+    m_quality = DetectionQuality::Full;
+    m_averageCost = 0.0;
+    m_windowCostSum = 0.0;
+    m_windowFrames = 0;
+    m_headroomWindows = 0;
+
+    if (fpsChanged) {
+        emit fpsAdjusted(m_currentFPS);
+    }
+    if (qualityChanged) {
+        emit qualityAdjusted(m_quality);
+    }
+}
+
+bool AdaptiveGovernor::recordFrameCost(double costMs) {
+    m_windowCostSum += costMs;
+    ++m_windowFrames;
+
+    if (m_windowFrames < m_evaluationWindow) {
+        return false;
+    }
+
+    double windowCost = m_windowCostSum / m_windowFrames;
+    m_windowCostSum = 0.0;
+    m_windowFrames = 0;
+
+    m_averageCost = (m_averageCost == 0.0) ? windowCost : m_averageCost * 0.7 + windowCost * 0.3;
+
+    if (!m_enabled) {
+        return false;
+    }
+
+    return evaluate(windowCost);
+}
+
+bool AdaptiveGovernor::evaluate(double windowCost) {
+    double periodMs = 1000.0 / m_currentFPS;
+    int newFPS = m_currentFPS;
+    DetectionQuality newQuality = m_quality;
+
+    // Over budget: cheaper detection cuts the cost itself, so try that first
+    if (windowCost > m_latencyBudget && m_quality != DetectionQuality::QuarterResolution) {
+        newQuality = static_cast<DetectionQuality>(static_cast<int>(m_quality) + 1);
+    }
+
+    // Cost close to the frame period: slow the cadence so ticks don't queue up
+    if (windowCost > periodMs * kCadenceHighWater) {
+        int sustainable = static_cast<int>(1000.0 / (windowCost / kCadenceHighWater));
+        newFPS = std::clamp(sustainable, m_minFPS, m_maxFPS);
+    }
+
+    bool underPressure = newQuality != m_quality || newFPS != m_currentFPS;
+
+    if (!underPressure &&
+        windowCost < m_latencyBudget * kBudgetLowWater &&
+        windowCost < periodMs * kCadenceLowWater) {
+        // Sustained headroom: restore quality before cadence
+        if (++m_headroomWindows >= kHeadroomWindowsToUpgrade) {
+            m_headroomWindows = 0;
+            if (m_quality != DetectionQuality::Full) {
+                newQuality = static_cast<DetectionQuality>(static_cast<int>(m_quality) - 1);
+            } else if (m_currentFPS < m_maxFPS) {
+                newFPS = std::min(m_maxFPS, static_cast<int>(std::ceil(m_currentFPS * 1.1)));
+            }
+        }
+    } else {
+        m_headroomWindows = 0;
+    }
+
+    bool changed = false;
+
+    if (newQuality != m_quality) {
+        m_quality = newQuality;
+        ++m_adjustmentCount;
+        changed = true;
+        emit qualityAdjusted(m_quality);
+    }
+
+    if (newFPS != m_currentFPS) {
+        m_currentFPS = newFPS;
+        ++m_adjustmentCount;
+        changed = true;
+        emit fpsAdjusted(m_currentFPS);
+    }
+
+    return changed;
+}
+
+int AdaptiveGovernor::getCurrentFPS() const {
+    return m_currentFPS;
+}
+
+DetectionQuality AdaptiveGovernor::getQuality() const {
+    return m_quality;
+}
+
+double AdaptiveGovernor::getAverageCost() const {
+    return m_averageCost;
+}
+
+int AdaptiveGovernor::getAdjustmentCount() const {
+    return m_adjustmentCount;
+}
@@ -0,0 +1,317 @@
+#include "core/ColorCalibrator.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+struct HsvBox {
+    int lower[3];
+    int upper[3];   // Inclusive bin indices
+};
+
+// Inclusive 3D prefix sums over a histogram, with hue rotated by hueShift
+// bins so a box never has to wrap
+class BoxCounter {
+public:
+    BoxCounter(const std::vector<quint32>& histogram, const int (&bins)[3], int hueShift)
+        : m_stride{(bins[1] + 1) * (bins[2] + 1), bins[2] + 1}
+        , m_sums(static_cast<size_t>(bins[0] + 1) * m_stride[0], 0)
+    {
+        // Unsigned wrap-around in the intermediate terms cancels out
+        for (int h = 1; h <= bins[0]; ++h) {
+            int sourceHue = (h - 1 - hueShift + bins[0]) % bins[0];
+            for (int s = 1; s <= bins[1]; ++s) {
+                for (int v = 1; v <= bins[2]; ++v) {
+                    quint64 cell = histogram[(static_cast<size_t>(sourceHue) * bins[1] + (s - 1)) * bins[2] + (v - 1)];
+                    at(h, s, v) = cell
+                        + at(h - 1, s, v) + at(h, s - 1, v) + at(h, s, v - 1)
+                        - at(h - 1, s - 1, v) - at(h - 1, s, v - 1) - at(h, s - 1, v - 1)
+                        + at(h - 1, s - 1, v - 1);
+                }
+            }
+        }
+    }
+    
+    quint64 count(const HsvBox& box) const {
+        int h0 = box.lower[0], s0 = box.lower[1], v0 = box.lower[2];
+        int h1 = box.upper[0] + 1, s1 = box.upper[1] + 1, v1 = box.upper[2] + 1;
+        return at(h1, s1, v1)
+            - at(h0, s1, v1) - at(h1, s0, v1) - at(h1, s1, v0)
+            + at(h0, s0, v1) + at(h0, s1, v0) + at(h1, s0, v0)
+            - at(h0, s0, v0);
+    }
+
+private:
+    int m_stride[2];
+    std::vector<quint64> m_sums;
+    
+    quint64& at(int h, int s, int v) {
+        return m_sums[static_cast<size_t>(h) * m_stride[0] + s * m_stride[1] + v];
+    }
+    quint64 at(int h, int s, int v) const {
+        return m_sums[static_cast<size_t>(h) * m_stride[0] + s * m_stride[1] + v];
+    }
+};
+}
+
+ColorCalibrator::ColorCalibrator()
+    : m_minTargetCoverage(0.95)
+{
+    reset();
+}
+
+void ColorCalibrator::reset() {
+    size_t bins = static_cast<size_t>(kHueBins) * kSatBins * kValBins;
+    m_target.assign(bins, 0);
+    m_background.assign(bins, 0);
+    m_targetCount = 0;
+    m_backgroundCount = 0;
+    m_targetSum[0] = m_targetSum[1] = m_targetSum[2] = 0.0;
+}
+
+void ColorCalibrator::addTarget(const cv::Mat& bgr, const cv::Mat& mask) {
+    accumulate(bgr, mask, m_target, m_targetCount, m_targetSum);
+}
+
+void ColorCalibrator::addBackground(const cv::Mat& bgr, const cv::Mat& mask) {
+    accumulate(bgr, mask, m_background, m_backgroundCount, nullptr);
+}
+
+quint64 ColorCalibrator::getTargetCount() const {
+    return m_targetCount;
+}
+
+quint64 ColorCalibrator::getBackgroundCount() const {
+    return m_backgroundCount;
+}
+
+void ColorCalibrator::setMinTargetCoverage(double coverage) {
+    m_minTargetCoverage = std::clamp(coverage, 0.5, 1.0);
+}
+
+double ColorCalibrator::getMinTargetCoverage() const {
+    return m_minTargetCoverage;
+}
+
+void ColorCalibrator::accumulate(const cv::Mat& bgr, const cv::Mat& mask, std::vector<quint32>& histogram,
+                                 quint64& count, double* colorSum) {
+    if (bgr.empty() || bgr.type() != CV_8UC3) {
+        return;
+    }
+    bool masked = !mask.empty() && mask.size() == bgr.size() && mask.type() == CV_8U;
+    
+    cv::Mat hsv;
+    cv::cvtColor(bgr, hsv, cv::COLOR_BGR2HSV);
+    
+    for (int y = 0; y < hsv.rows; ++y) {
+        const uchar* hsvRow = hsv.ptr<uchar>(y);
+        const uchar* bgrRow = bgr.ptr<uchar>(y);
+        const uchar* maskRow = masked ? mask.ptr<uchar>(y) : nullptr;
+        
+        for (int x = 0; x < hsv.cols; ++x) {
+            if (maskRow && !maskRow[x]) {
+                continue;
+            }
+            
+            const uchar* pixel = hsvRow + x * 3;
+            int hue = std::min(pixel[0] / 2, kHueBins - 1);
+            size_t bin = (static_cast<size_t>(hue) * kSatBins + pixel[1] / 8) * kValBins + pixel[2] / 8;
+            ++histogram[bin];
+            ++count;
+            
+            if (colorSum) {
+                colorSum[0] += bgrRow[x * 3];
+                colorSum[1] += bgrRow[x * 3 + 1];
+                colorSum[2] += bgrRow[x * 3 + 2];
+            }
+        }
+    }
+}
+
+ColorCalibration ColorCalibrator::compute() const {
+    ColorCalibration result;
+    result.targetPixels = m_targetCount;
+    result.backgroundPixels = m_backgroundCount;
+    if (m_targetCount < kMinTargetPixels) {
+        return result;
+    }
+    
+    double pixels = static_cast<double>(m_targetCount);
+    result.meanColor = QColor(qRound(m_targetSum[2] / pixels), qRound(m_targetSum[1] / pixels),
+                              qRound(m_targetSum[0] / pixels));
+    
+    const int bins[3] = {kHueBins, kSatBins, kValBins};
+    
+    // Marginal target histograms; hue is circular, so its mean comes from
+    // the angle sum and the search runs with that mean rotated to mid-range
+    std::vector<quint64> marginals[3] = {std::vector<quint64>(kHueBins, 0), std::vector<quint64>(kSatBins, 0),
+                                         std::vector<quint64>(kValBins, 0)};
+    double sumX = 0.0, sumY = 0.0;
+    for (int h = 0; h < kHueBins; ++h) {
+        for (int s = 0; s < kSatBins; ++s) {
+            for (int v = 0; v < kValBins; ++v) {
+                quint32 cell = m_target[(static_cast<size_t>(h) * kSatBins + s) * kValBins + v];
+                marginals[0][h] += cell;
+                marginals[1][s] += cell;
+                marginals[2][v] += cell;
+            }
+        }
+        double angle = (h + 0.5) * 2.0 * CV_PI / kHueBins;
+        sumX += marginals[0][h] * std::cos(angle);
+        sumY += marginals[0][h] * std::sin(angle);
+    }
+    
+    int meanHue = static_cast<int>(std::floor(std::atan2(sumY, sumX) * kHueBins / (2.0 * CV_PI)));
+    int hueShift = ((kHueBins / 2 - meanHue) % kHueBins + kHueBins) % kHueBins;
+    std::rotate(marginals[0].begin(), marginals[0].end() - hueShift, marginals[0].end());
+    
+    // Start from the box that trims an equal sliver of target mass off
+    // each of the six faces
+    HsvBox box;
+    quint64 trim = static_cast<quint64>((1.0 - m_minTargetCoverage) / 6.0 * pixels);
+    for (int axis = 0; axis < 3; ++axis) {
+        quint64 below = 0;
+        int lower = 0;
+        while (lower < bins[axis] - 1 && below + marginals[axis][lower] <= trim) {
+            below += marginals[axis][lower++];
+        }
+        quint64 above = 0;
+        int upper = bins[axis] - 1;
+        while (upper > lower && above + marginals[axis][upper] <= trim) {
+            above += marginals[axis][upper--];
+        }
+        box.lower[axis] = lower;
+        box.upper[axis] = upper;
+    }
+    
+    BoxCounter targets(m_target, bins, hueShift);
+    BoxCounter background(m_background, bins, hueShift);
+    
+    quint64 minTargets = static_cast<quint64>(std::ceil(m_minTargetCoverage * pixels));
+    quint64 inTarget = targets.count(box);
+    quint64 inBackground = background.count(box);
+    
+    // Each step moves one face in by one bin. Faces that lose no target
+    // pixels go first (emptiest slices tighten for free); otherwise the
+    // most background removed per target pixel lost wins.
+    while (true) {
+        HsvBox best = box;
+        std::pair<int, double> bestScore(-1, 0.0);
+        quint64 bestTarget = 0, bestBackground = 0;
+        
+        for (int axis = 0; axis < 3; ++axis) {
+            if (box.lower[axis] == box.upper[axis]) {
+                continue;
+            }
+            for (int side = 0; side < 2; ++side) {
+                HsvBox next = box;
+                if (side == 0) {
+                    ++next.lower[axis];
+                } else {
+                    --next.upper[axis];
+                }
+                
+                quint64 nextTarget = targets.count(next);
+                if (nextTarget < minTargets) {
+                    continue;
+                }
+                quint64 nextBackground = background.count(next);
+                quint64 lostTarget = inTarget - nextTarget;
+                quint64 droppedBackground = inBackground - nextBackground;
+                
+                std::pair<int, double> score;
+                if (lostTarget == 0) {
+                    score = {1, static_cast<double>(droppedBackground)};
+                } else if (droppedBackground > 0) {
+                    score = {0, static_cast<double>(droppedBackground) / lostTarget};
+                } else {
+                    continue;
+                }
+                
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = next;
+                    bestTarget = nextTarget;
+                    bestBackground = nextBackground;
+                }
+            }
+        }
+        
+        if (bestScore.first < 0) {
+            break;
+        }
+        box = best;
+        inTarget = bestTarget;
+        inBackground = bestBackground;
+    }
+    
+    // Back to OpenCV units; hue bins are un-rotated and may now wrap
+    CalibratedColorRange& range = result.range;
+    range.valid = true;
+    if (box.lower[0] == 0 && box.upper[0] == kHueBins - 1) {
+        range.lower[0] = 0;
+        range.upper[0] = 179;
+    } else {
+        range.lower[0] = ((box.lower[0] - hueShift + kHueBins) % kHueBins) * 2;
+        range.upper[0] = ((box.upper[0] - hueShift + kHueBins) % kHueBins) * 2 + 1;
+    }
+    for (int axis = 1; axis < 3; ++axis) {
+        range.lower[axis] = box.lower[axis] * 8;
+        range.upper[axis] = box.upper[axis] * 8 + 7;
+    }
+    
+    result.targetCoverage = inTarget / pixels;
+    result.backgroundRate = m_backgroundCount > 0 ? static_cast<double>(inBackground) / m_backgroundCount : 0.0;
+    
+    buildHueSatModel(box.lower[2], box.upper[2], result);
+    return result;
+}
+
+void ColorCalibrator::buildHueSatModel(int lowerValueBin, int upperValueBin, ColorCalibration& result) const {
+    constexpr int cellCount = kHueBins * kSatBins;
+    
+    // 2D hue-saturation histograms over the value range the box settled on
+    std::vector<quint64> target(cellCount, 0);
+    std::vector<quint64> background(cellCount, 0);
+    for (int cell = 0; cell < cellCount; ++cell) {
+        size_t first = static_cast<size_t>(cell) * kValBins;
+        for (int v = lowerValueBin; v <= upperValueBin; ++v) {
+            target[cell] += m_target[first + v];
+            background[cell] += m_background[first + v];
+        }
+    }
+    
+    // Back-projection with both classes normalised to equal mass, so the
+    // ratio reads as P(target | cell) regardless of how many pixels of each
+    // were sampled
+    double backgroundWeight = m_backgroundCount > 0 ? static_cast<double>(m_targetCount) / m_backgroundCount : 0.0;
+    std::vector<double> probability(cellCount, 0.0);
+    std::vector<int> order;
+    for (int cell = 0; cell < cellCount; ++cell) {
+        if (target[cell] > 0) {
+            probability[cell] = target[cell] / (target[cell] + background[cell] * backgroundWeight);
+            order.push_back(cell);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return probability[a] != probability[b] ? probability[a] > probability[b] : target[a] > target[b];
+    });
+    
+    auto model = std::make_shared<HueSatModel>();
+    model->setValueRange(lowerValueBin * 8, upperValueBin * 8 + 7);
+    
+    quint64 minTargets = static_cast<quint64>(std::ceil(m_minTargetCoverage * m_targetCount));
+    quint64 kept = 0, admitted = 0;
+    for (int cell : order) {
+        if (kept >= minTargets && probability[cell] < kBackProjectionThreshold) {
+            break;
+        }
+        model->cells[cell] = 255;
+        kept += target[cell];
+        admitted += background[cell];
+    }
+    
+    result.modelCoverage = static_cast<double>(kept) / m_targetCount;
+    result.modelBackgroundRate = m_backgroundCount > 0 ? static_cast<double>(admitted) / m_backgroundCount : 0.0;
+    result.hueSatModel = std::move(model);
+}
@@ -1,4 +1,5 @@
 #include "core/ColorDetection.h"
+#include "core/SettingsStore.h"
 #include <QElapsedTimer>
 #include <algorithm>
 #include <cmath>
@@ -8,20 +9,86 @@ ColorDetection::ColorDetection(QObject* parent)
     : QObject(parent)
     , m_targetColor(Qt::red)
     , m_colorTolerance(30)
+    , m_colorMatchMode(ColorMatchMode::Range)
     , m_fovRadius(150)
     , m_minArea(50.0)
     , m_maxArea(50000.0)
     , m_morphologyEnabled(true)
+    , m_quality(DetectionQuality::Full)
     , m_lastDetectionTime(0.0)
     , m_lastTargetCount(0)
+    , m_settingsVersion(0)
+    , m_signalsEnabled(false)
+    , m_colorRangeDirty(true)
+    , m_fovMaskRadius(0)
 {
 }
 
 ColorDetection::~ColorDetection() {
 }
 
+void ColorDetection::applySettings(const DetectionSettings& settings) {
+    if (settings.version == m_settingsVersion) {
+        return;
+    }
+    
+    setTargetColor(settings.targetColor);
+    setColorTolerance(settings.colorTolerance);
+    setCalibratedRange(settings.calibratedRange);
+    setColorMatchMode(settings.colorMatchMode);
+    setHueSatModel(settings.hueSatModel);
+    setFOVRadius(settings.fovRadius);
+    setMinArea(settings.minArea);
+    setMaxArea(settings.maxArea);
+    setMorphologyEnabled(settings.morphologyEnabled);
+    m_settingsVersion = settings.version;
+    
+    // Precomputed data is only trusted while it matches the live values;
+    // snapshots edited after preparation carry a stale copy
+    m_derived = settings.derived;
+    if (m_derived && m_derived->targetColor == m_targetColor &&
+        m_derived->colorTolerance == m_colorTolerance && m_derived->calibratedRange == m_calibratedRange) {
+        m_colorRange = m_derived->colorRange;
+        m_colorRangeDirty = false;
+    }
+}
+
+std::shared_ptr<const DetectionDerived> ColorDetection::prepare(const DetectionSettings& settings,
+                                                                const cv::Size& frameSize,
+                                                                const QPoint& aimPoint) {
+    auto derived = std::make_shared<DetectionDerived>();
+    
+    // Same clamping as the setters, so the result matches what detect() sees
+    derived->targetColor = settings.targetColor;
+    derived->colorTolerance = std::clamp(settings.colorTolerance, 0, 100);
+    derived->calibratedRange = settings.calibratedRange;
+    derived->colorRange = resolveColorRange(derived->targetColor, derived->colorTolerance,
+                                            derived->calibratedRange);
+    derived->fovRadius = std::clamp(settings.fovRadius, 50, 500);
+    derived->frameSize = frameSize;
+    derived->aimPoint = aimPoint;
+    
+    // Each level is sized the way cv::pyrDown sizes it
+    cv::Size levelSize = frameSize;
+    for (int level = 0; level < 3; ++level) {
+        int scale = 1 << level;
+        derived->fovMasks[level] = createFOVMask(levelSize, QPoint(aimPoint.x() / scale, aimPoint.y() / scale),
+                                                 derived->fovRadius / scale);
+        levelSize = cv::Size((levelSize.width + 1) / 2, (levelSize.height + 1) / 2);
+    }
+    
+    return derived;
+}
+
+quint64 ColorDetection::getSettingsVersion() const {
+    return m_settingsVersion;
+}
+
 void ColorDetection::setTargetColor(const QColor& color) {
-    m_targetColor = color;
+    if (color != m_targetColor) {
+        m_targetColor = color;
+        m_colorRangeDirty = true;
+    }
 }
 
 QColor ColorDetection::getTargetColor() const {
@@ -29,13 +96,46 @@ QColor ColorDetection::getTargetColor() const {
 }
 
 void ColorDetection::setColorTolerance(int tolerance) {
-    m_colorTolerance = std::clamp(tolerance, 0, 100);
+    tolerance = std::clamp(tolerance, 0, 100);
+    if (tolerance != m_colorTolerance) {
+        m_colorTolerance = tolerance;
+        m_colorRangeDirty = true;
+    }
 }
 
 int ColorDetection::getColorTolerance() const {
     return m_colorTolerance;
 }
 
+void ColorDetection::setCalibratedRange(const CalibratedColorRange& range) {
+    if (range != m_calibratedRange) {
+        m_calibratedRange = range;
+        m_colorRangeDirty = true;
+    }
+}
+
+CalibratedColorRange ColorDetection::getCalibratedRange() const {
+    return m_calibratedRange;
+}
+
+void ColorDetection::setColorMatchMode(ColorMatchMode mode) {
+    m_colorMatchMode = mode;
+}
+
+ColorMatchMode ColorDetection::getColorMatchMode() const {
+    return m_colorMatchMode;
+}
+
+void ColorDetection::setHueSatModel(const std::shared_ptr<const HueSatModel>& model) {
+    // The model is immutable, so holding the pointer is enough; no tables
+    // are rebuilt on the pipeline thread
+    m_hueSatModel = model;
+}
+
+std::shared_ptr<const HueSatModel> ColorDetection::getHueSatModel() const {
+    return m_hueSatModel;
+}
+
 void ColorDetection::setFOVRadius(int radius) {
     m_fovRadius = std::clamp(radius, 50, 500);
 }
@@ -68,6 +168,14 @@ bool ColorDetection::isMorphologyEnabled() const {
     return m_morphologyEnabled;
 }
 
+void ColorDetection::setQuality(DetectionQuality quality) {
+    m_quality = quality;
+}
+
+DetectionQuality ColorDetection::getQuality() const {
+    return m_quality;
+}
+
 double ColorDetection::getLastDetectionTime() const {
     return m_lastDetectionTime;
 }
@@ -76,6 +184,14 @@ int ColorDetection::getLastTargetCount() const {
     return m_lastTargetCount;
 }
 
+void ColorDetection::setSignalsEnabled(bool enabled) {
+    m_signalsEnabled = enabled;
+}
+
+bool ColorDetection::isSignalsEnabled() const {
+    return m_signalsEnabled;
+}
+
 ColorRange ColorDetection::calculateColorRange(const QColor& color, int tolerance) {
     // Convert QColor to HSV
     int h, s, v;
@@ -103,6 +219,65 @@ ColorRange ColorDetection::calculateColorRange(const QColor& color, int toleranc
     return range;
 }
 
+ColorRange ColorDetection::resolveColorRange(const QColor& color, int tolerance,
+                                             const CalibratedColorRange& calibrated) {
+    if (!calibrated.valid) {
+        return calculateColorRange(color, tolerance);
+    }
+    
+    ColorRange range;
+    range.lower = cv::Scalar(calibrated.lower[0], calibrated.lower[1], calibrated.lower[2]);
+    range.upper = cv::Scalar(calibrated.upper[0], calibrated.upper[1], calibrated.upper[2]);
+    return range;
+}
+
+void ColorDetection::applyColorRange(const cv::Mat& hsv, const ColorRange& range, cv::Mat& mask) {
+    if (range.lower[0] <= range.upper[0]) {
+        cv::inRange(hsv, range.lower, range.upper, mask);
+        return;
+    }
+    
+    // Calibrated reds wrap past hue 179: two bands, merged
+    cv::Mat wrapped;
+    cv::inRange(hsv, range.lower, cv::Scalar(179, range.upper[1], range.upper[2]), mask);
+    cv::inRange(hsv, cv::Scalar(0, range.lower[1], range.lower[2]), range.upper, wrapped);
+    cv::bitwise_or(mask, wrapped, mask);
+}
+
+void ColorDetection::applyHueSatModel(const cv::Mat& hsv, const HueSatModel& model, cv::Mat& mask) {
+    // One scalar pass with two table lookups per pixel. Unlike inRange this
+    // is not vectorised: it costs somewhat more than a single inRange, less
+    // than the two a hue-wrapping range needs
+    mask.create(hsv.size(), CV_8U);
+    const uchar* cells = model.cells.data();
+    const uchar* values = model.valueMask.data();
+    
+    for (int y = 0; y < hsv.rows; ++y) {
+        const uchar* pixel = hsv.ptr<uchar>(y);
+        uchar* out = mask.ptr<uchar>(y);
+        for (int x = 0; x < hsv.cols; ++x, pixel += 3) {
+            out[x] = cells[HueSatModel::cellIndex(pixel[0], pixel[1])] & values[pixel[2]];
+        }
+    }
+}
+
+const cv::Mat& ColorDetection::fovMask(const cv::Size& frameSize, const QPoint& center, int radius, int level) {
+    // A prepared mask for exactly this geometry needs no work at all
+    if (m_derived && m_derived->fovRadius == m_fovRadius && level < 3 &&
+        m_derived->fovMasks[level].size() == frameSize &&
+        QPoint(m_derived->aimPoint.x() / (1 << level), m_derived->aimPoint.y() / (1 << level)) == center) {
+        return m_derived->fovMasks[level];
+    }
+    
+    // The mask only changes with the FOV, the aim point or the pyramid level
+    if (m_fovMask.size() != frameSize || m_fovMaskCenter != center || m_fovMaskRadius != radius) {
+        m_fovMask = createFOVMask(frameSize, center, radius);
+        m_fovMaskCenter = center;
+        m_fovMaskRadius = radius;
+    }
+    return m_fovMask;
+}
+
 cv::Mat ColorDetection::createFOVMask(const cv::Size& frameSize, const QPoint& center, int radius) {
     cv::Mat mask = cv::Mat::zeros(frameSize, CV_8UC1);
     cv::circle(mask, cv::Point(center.x(), center.y()), radius, cv::Scalar(255), -1);
@@ -122,14 +297,15 @@ cv::Mat ColorDetection::applyMorphology(const cv::Mat& mask) {
     return result;
 }
 
-std::vector<DetectedTarget> ColorDetection::findTargets(const cv::Mat& mask, const QPoint& screenCenter) {
+std::vector<DetectedTarget> ColorDetection::findTargets(const cv::Mat& mask, const QPoint& aimPoint, int scale) {
     std::vector<DetectedTarget> targets;
     
     std::vector<std::vector<cv::Point>> contours;
     cv::findContours(mask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
     
     for (const auto& contour : contours) {
-        double area = cv::contourArea(contour);
+        // Mask may be downscaled; areas and coordinates are reported at full resolution
+        double area = cv::contourArea(contour) * scale * scale;
         
         if (area < m_minArea || area > m_maxArea) {
             continue;
@@ -140,17 +316,17 @@ std::vector<DetectedTarget> ColorDetection::findTargets(const cv::Mat& mask, con
         
         if (moments.m00 == 0) continue;
         
-        int centerX = static_cast<int>(moments.m10 / moments.m00);
-        int centerY = static_cast<int>(moments.m01 / moments.m00);
+        int centerX = static_cast<int>(moments.m10 / moments.m00) * scale;
+        int centerY = static_cast<int>(moments.m01 / moments.m00) * scale;
         
-        double dx = centerX - screenCenter.x();
-        double dy = centerY - screenCenter.y();
+        double dx = centerX - aimPoint.x();
+        double dy = centerY - aimPoint.y();
         double distance = std::sqrt(dx * dx + dy * dy);
         
         DetectedTarget target;
         target.center = QPoint(centerX, centerY);
-        target.boundingBox = QRect(boundingRect.x, boundingRect.y, 
-                                   boundingRect.width, boundingRect.height);
+        target.boundingBox = QRect(boundingRect.x * scale, boundingRect.y * scale, 
+                                   boundingRect.width * scale, boundingRect.height * scale);
         target.area = area;
         target.distanceFromCenter = distance;
         target.confidence = calculateConfidence(area, distance);
@@ -175,7 +351,7 @@ double ColorDetection::calculateConfidence(double area, double distanceFromCente
     return (areaScore * 0.4 + distanceScore * 0.6);
 }
 
-std::vector<DetectedTarget> ColorDetection::detect(const cv::Mat& frame, const QPoint& screenCenter) {
+std::vector<DetectedTarget> ColorDetection::detect(const cv::Mat& frame, const QPoint& aimPoint) {
     QElapsedTimer timer;
     timer.start();
     
@@ -185,37 +361,60 @@ std::vector<DetectedTarget> ColorDetection::detect(const cv::Mat& frame, const Q
         return {};
     }
     
+    // Reduced quality levels work on a downscaled pyramid level
+    int pyramidLevels = 0;
+    if (m_quality == DetectionQuality::HalfResolution) {
+        pyramidLevels = 1;
+    } else if (m_quality == DetectionQuality::QuarterResolution) {
+        pyramidLevels = 2;
+    }
+    
+    cv::Mat input = frame;
+    for (int i = 0; i < pyramidLevels; ++i) {
+        cv::pyrDown(input, input);
+    }
+    int scale = 1 << pyramidLevels;
+    
     // Convert to HSV
     cv::Mat hsv;
-    cv::cvtColor(frame, hsv, cv::COLOR_BGR2HSV);
+    cv::cvtColor(input, hsv, cv::COLOR_BGR2HSV);
     
-    // Calculate color range
-    ColorRange range = calculateColorRange(m_targetColor, m_colorTolerance);
+    // Color range is recomputed only after the color, tolerance or
+    // calibration changed
+    if (m_colorRangeDirty) {
+        m_colorRange = resolveColorRange(m_targetColor, m_colorTolerance, m_calibratedRange);
+        m_colorRangeDirty = false;
+    }
     
     // Create color mask
     cv::Mat colorMask;
-    cv::inRange(hsv, range.lower, range.upper, colorMask);
+    if (m_colorMatchMode == ColorMatchMode::BackProjection && m_hueSatModel) {
+        applyHueSatModel(hsv, *m_hueSatModel, colorMask);
+    } else {
+        applyColorRange(hsv, m_colorRange, colorMask);
+    }
     
     // Apply FOV mask
-    QPoint frameCenter(frame.cols / 2, frame.rows / 2);
-    cv::Mat fovMask = createFOVMask(frame.size(), frameCenter, m_fovRadius);
-    cv::bitwise_and(colorMask, fovMask, colorMask);
+    QPoint maskCenter(aimPoint.x() / scale, aimPoint.y() / scale);
+    cv::bitwise_and(colorMask, fovMask(input.size(), maskCenter, m_fovRadius / scale, pyramidLevels), colorMask);
     
-    // Apply morphology if enabled
-    if (m_morphologyEnabled) {
+    // Apply morphology if enabled and the current quality allows it
+    if (m_morphologyEnabled && m_quality == DetectionQuality::Full) {
         colorMask = applyMorphology(colorMask);
     }
     
     // Find targets
-    std::vector<DetectedTarget> targets = findTargets(colorMask, frameCenter);
+    std::vector<DetectedTarget> targets = findTargets(colorMask, aimPoint, scale);
     
-    m_lastDetectionTime = timer.elapsed();
+    m_lastDetectionTime = timer.nsecsElapsed() / 1e6;
     m_lastTargetCount = static_cast<int>(targets.size());
     
-    emit detectionComplete(m_lastTargetCount, m_lastDetectionTime);
-    
-    if (!targets.empty()) {
-        emit targetDetected(targets[0]);
+    if (m_signalsEnabled) {
+        emit detectionComplete(m_lastTargetCount, m_lastDetectionTime);
+        
+        if (!targets.empty()) {
+            emit targetDetected(targets[0]);
+        }
     }
     
     return targets;
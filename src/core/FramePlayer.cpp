@@ -0,0 +1,217 @@
+#include "core/FramePlayer.h"
+#include <cstring>
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+using namespace recording;
+
+FramePlayer::FramePlayer(QObject* parent)
+    : QObject(parent)
+    , m_data(nullptr)
+    , m_size(0)
+{
+}
+
+FramePlayer::~FramePlayer() {
+    close();
+}
+
+bool FramePlayer::open(const QString& filePath) {
+    close();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return fail(QString("Cannot open recording: %1").arg(m_file.errorString()));
+    }
+
+    m_size = static_cast<quint64>(m_file.size());
+    if (m_size < sizeof(RecordingHeader)) {
+        return fail("Recording is truncated");
+    }
+
+    m_data = m_file.map(0, m_file.size());
+    if (!m_data) {
+        return fail(QString("Cannot map recording: %1").arg(m_file.errorString()));
+    }
+
+    RecordingHeader header;
+    std::memcpy(&header, m_data, sizeof(header));
+
+    if (std::memcmp(header.magic, kFileMagic, sizeof(header.magic)) != 0) {
+        return fail("Not a frame recording");
+    }
+    if (header.version != kFormatVersion) {
+        return fail(QString("Unsupported recording version %1").arg(header.version));
+    }
+    if (sizeof(header) + static_cast<quint64>(header.configSize) > m_size) {
+        return fail("Recording header is corrupt");
+    }
+
+    m_configSnapshot = QByteArray(reinterpret_cast<const char*>(m_data + sizeof(header)),
+                                  static_cast<int>(header.configSize));
+
+    // A recording interrupted mid-session has no trailer; recover by scanning
+    if (!readIndex() && !rebuildIndex()) {
+        return fail("Recording index is corrupt");
+    }
+
+    return true;
+}
+
+void FramePlayer::close() {
+    if (m_data) {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_size = 0;
+    m_index.clear();
+    m_configSnapshot.clear();
+    m_decodeBuffer.clear();
+}
+
+bool FramePlayer::isOpen() const {
+    return m_data != nullptr;
+}
+
+QString FramePlayer::getErrorString() const {
+    return m_errorString;
+}
+
+QByteArray FramePlayer::getConfigSnapshot() const {
+    return m_configSnapshot;
+}
+
+int FramePlayer::getFrameCount() const {
+    return static_cast<int>(m_index.size());
+}
+
+qint64 FramePlayer::getFrameTimestamp(int index) const {
+    if (index < 0 || index >= static_cast<int>(m_index.size())) {
+        return 0;
+    }
+    return m_index[index].timestampNs;
+}
+
+cv::Mat FramePlayer::frame(int index) {
+    if (index < 0 || index >= static_cast<int>(m_index.size())) {
+        return cv::Mat();
+    }
+
+    quint64 chunkOffset = m_index[index].chunkOffset;
+    const FrameChunkHeader* chunk = chunkAt(chunkOffset);
+    if (!chunk) {
+        return cv::Mat();
+    }
+
+    uchar* payload = m_data + alignPayload(chunkOffset + sizeof(FrameChunkHeader));
+
+    if (!(chunk->flags & ChunkCompressedLZ4)) {
+        // Zero-copy: the Mat header points straight into the mapping
+        return cv::Mat(chunk->height, chunk->width, chunk->type, payload, chunk->step);
+    }
+
+#ifdef HAVE_LZ4
+    m_decodeBuffer.resize(chunk->rawSize);
+    int decoded = LZ4_decompress_safe(reinterpret_cast<const char*>(payload),
+                                      reinterpret_cast<char*>(m_decodeBuffer.data()),
+                                      static_cast<int>(chunk->storedSize),
+                                      static_cast<int>(chunk->rawSize));
+    if (decoded != static_cast<int>(chunk->rawSize)) {
+        return cv::Mat();
+    }
+    return cv::Mat(chunk->height, chunk->width, chunk->type, m_decodeBuffer.data(), chunk->step);
+#else
+    m_errorString = "Recording uses LZ4 but this build has no LZ4 support";
+    return cv::Mat();
+#endif
+}
+
+bool FramePlayer::readIndex() {
+    if (m_size < sizeof(RecordingTrailer)) {
+        return false;
+    }
+
+    RecordingTrailer trailer;
+    std::memcpy(&trailer, m_data + m_size - sizeof(trailer), sizeof(trailer));
+
+    if (trailer.magic != kTrailerMagic) {
+        return false;
+    }
+
+    quint64 indexBytes = trailer.frameCount * sizeof(FrameIndexEntry);
+    if (trailer.indexOffset + indexBytes + sizeof(trailer) != m_size) {
+        return false;
+    }
+
+    m_index.resize(trailer.frameCount);
+    if (indexBytes > 0) {
+        std::memcpy(m_index.data(), m_data + trailer.indexOffset, indexBytes);
+    }
+
+    for (const auto& entry : m_index) {
+        if (!chunkAt(entry.chunkOffset)) {
+            m_index.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FramePlayer::rebuildIndex() {
+    m_index.clear();
+
+    RecordingHeader header;
+    std::memcpy(&header, m_data, sizeof(header));
+    quint64 offset = sizeof(header) + header.configSize;
+
+    while (const FrameChunkHeader* chunk = chunkAt(offset)) {
+        m_index.push_back({offset, chunk->timestampNs});
+        offset = alignPayload(offset + sizeof(FrameChunkHeader)) + chunk->storedSize;
+    }
+
+    // Any trailing bytes are a partially written frame; they are ignored
+    return true;
+}
+
+bool FramePlayer::fail(const QString& error) {
+    m_errorString = error;
+    close();
+    return false;
+}
+
+const FrameChunkHeader* FramePlayer::chunkAt(quint64 offset) const {
+    if (offset + sizeof(FrameChunkHeader) > m_size) {
+        return nullptr;
+    }
+
+    // Chunk headers are packed and may be unaligned; the struct has byte alignment
+    const FrameChunkHeader* chunk = reinterpret_cast<const FrameChunkHeader*>(m_data + offset);
+    if (chunk->magic != kChunkMagic) {
+        return nullptr;
+    }
+
+    quint64 payloadEnd = alignPayload(offset + sizeof(FrameChunkHeader)) + chunk->storedSize;
+    if (payloadEnd > m_size) {
+        return nullptr;
+    }
+
+    // The recorder only writes 8-bit frames; anything else, or rows shorter
+    // than the pixels they hold, would make the cv::Mat constructor throw
+    if (chunk->type != CV_8UC1 && chunk->type != CV_8UC3 && chunk->type != CV_8UC4) {
+        return nullptr;
+    }
+    if (chunk->width <= 0 || chunk->height <= 0 ||
+        static_cast<quint64>(chunk->step) < static_cast<quint64>(chunk->width) * CV_ELEM_SIZE(chunk->type) ||
+        static_cast<quint64>(chunk->step) * static_cast<quint64>(chunk->height) != chunk->rawSize) {
+        return nullptr;
+    }
+    if (!(chunk->flags & ChunkCompressedLZ4) && chunk->storedSize != chunk->rawSize) {
+        return nullptr;
+    }
+    return chunk;
+}
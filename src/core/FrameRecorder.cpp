@@ -0,0 +1,287 @@
+#include "core/FrameRecorder.h"
+#include "core/ResourceMonitor.h"
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+#include <cstring>
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+using namespace recording;
+
+FrameRecorder::FrameRecorder(QObject* parent)
+    : QObject(parent)
+    , m_compressionEnabled(isCompressionAvailable())
+    , m_maxQueuedFrames(120)
+    , m_stopRequested(false)
+    , m_isRecording(false)
+    , m_writeOffset(0)
+    , m_framesWritten(0)
+    , m_framesDropped(0)
+    , m_bytesWritten(0)
+{
+}
+
+FrameRecorder::~FrameRecorder() {
+    stop();
+}
+
+bool FrameRecorder::start(const QString& filePath, const QByteArray& configSnapshot) {
+    if (m_isRecording) {
+        return false;
+    }
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        emit recordingError(QString("Cannot open recording file: %1").arg(m_file.errorString()));
+        return false;
+    }
+
+    m_filePath = filePath;
+    m_index.clear();
+    m_writeOffset = 0;
+    m_framesWritten = 0;
+    m_framesDropped = 0;
+    m_bytesWritten = 0;
+
+    // Header and config snapshot are written up front on the caller's thread
+    RecordingHeader header = {};
+    std::memcpy(header.magic, kFileMagic, sizeof(header.magic));
+    header.version = kFormatVersion;
+    header.configSize = static_cast<quint32>(configSnapshot.size());
+
+    if (!writeBytes(&header, sizeof(header)) ||
+        !writeBytes(configSnapshot.constData(), configSnapshot.size())) {
+        m_file.close();
+        emit recordingError(QString("Cannot write recording header: %1").arg(m_file.errorString()));
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_queue.clear();
+        m_stopRequested = false;
+    }
+
+    m_isRecording = true;
+    m_writerThread = std::thread(&FrameRecorder::writerLoop, this);
+
+    emit recordingStarted(filePath);
+    return true;
+}
+
+void FrameRecorder::stop() {
+    if (!m_isRecording) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stopRequested = true;
+    }
+    m_queueCondition.notify_one();
+
+    if (m_writerThread.joinable()) {
+        m_writerThread.join();
+    }
+
+    m_file.close();
+    m_isRecording = false;
+
+    emit recordingStopped(m_framesWritten);
+}
+
+bool FrameRecorder::isRecording() const {
+    return m_isRecording;
+}
+
+QString FrameRecorder::getFilePath() const {
+    return m_filePath;
+}
+
+bool FrameRecorder::pushFrame(const cv::Mat& frame, qint64 timestampNs) {
+    if (!m_isRecording || frame.empty()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        if (static_cast<int>(m_queue.size()) >= m_maxQueuedFrames) {
+            ++m_framesDropped;
+            return false;
+        }
+        m_queue.push_back({frame, timestampNs});
+    }
+    m_queueCondition.notify_one();
+    return true;
+}
+
+void FrameRecorder::setCompressionEnabled(bool enabled) {
+    m_compressionEnabled = enabled && isCompressionAvailable();
+}
+
+bool FrameRecorder::isCompressionEnabled() const {
+    return m_compressionEnabled;
+}
+
+bool FrameRecorder::isCompressionAvailable() {
+#ifdef HAVE_LZ4
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FrameRecorder::setMaxQueuedFrames(int frames) {
+    m_maxQueuedFrames = std::clamp(frames, 1, 10000);
+}
+
+int FrameRecorder::getMaxQueuedFrames() const {
+    return m_maxQueuedFrames;
+}
+
+quint64 FrameRecorder::getFramesWritten() const {
+    return m_framesWritten;
+}
+
+quint64 FrameRecorder::getFramesDropped() const {
+    return m_framesDropped;
+}
+
+quint64 FrameRecorder::getBytesWritten() const {
+    return m_bytesWritten;
+}
+
+void FrameRecorder::writerLoop() {
+    ResourceMonitor::setCurrentThreadName("FrameRecorder");
+    bool failed = false;
+
+    while (true) {
+        PendingFrame pending;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait(lock, [this]() {
+                return m_stopRequested || !m_queue.empty();
+            });
+
+            if (m_queue.empty()) {
+                break; // Stop requested and queue drained
+            }
+
+            pending = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        if (failed) {
+            continue; // Keep draining so producers never block
+        }
+
+        if (!writeFrame(pending)) {
+            failed = true;
+            emit recordingError(QString("Frame write failed: %1").arg(m_file.errorString()));
+        }
+    }
+
+    if (!failed && !writeIndex()) {
+        emit recordingError(QString("Index write failed: %1").arg(m_file.errorString()));
+    }
+    m_file.flush();
+}
+
+bool FrameRecorder::writeFrame(const PendingFrame& pending) {
+    const cv::Mat& image = pending.image;
+
+    FrameChunkHeader chunk = {};
+    chunk.magic = kChunkMagic;
+    chunk.frameIndex = m_index.size();
+    chunk.timestampNs = pending.timestampNs;
+    chunk.width = image.cols;
+    chunk.height = image.rows;
+    chunk.type = image.type();
+    chunk.step = static_cast<quint32>(image.cols * image.elemSize());
+    chunk.rawSize = chunk.step * static_cast<quint32>(image.rows);
+
+    const char* payload = nullptr;
+    quint32 payloadSize = chunk.rawSize;
+
+    // ROI views of a larger capture are not continuous; pack them first
+    if (image.isContinuous()) {
+        payload = reinterpret_cast<const char*>(image.data);
+    } else {
+        m_scratch.resize(chunk.rawSize);
+        for (int row = 0; row < image.rows; ++row) {
+            std::memcpy(m_scratch.data() + row * chunk.step, image.ptr(row), chunk.step);
+        }
+        payload = m_scratch.data();
+    }
+
+#ifdef HAVE_LZ4
+    std::vector<char> compressed;
+    if (m_compressionEnabled) {
+        int bound = LZ4_compressBound(static_cast<int>(chunk.rawSize));
+        compressed.resize(bound);
+        int size = LZ4_compress_default(payload, compressed.data(),
+                                        static_cast<int>(chunk.rawSize), bound);
+        // Only keep the compressed form if it actually saves space
+        if (size > 0 && static_cast<quint32>(size) < chunk.rawSize) {
+            chunk.flags |= ChunkCompressedLZ4;
+            payload = compressed.data();
+            payloadSize = static_cast<quint32>(size);
+        }
+    }
+#endif
+
+    chunk.storedSize = payloadSize;
+
+    quint64 chunkOffset = m_writeOffset;
+    if (!writeBytes(&chunk, sizeof(chunk))) {
+        return false;
+    }
+    if (!writePadding(alignPayload(m_writeOffset))) {
+        return false;
+    }
+    if (!writeBytes(payload, payloadSize)) {
+        return false;
+    }
+
+    m_index.push_back({chunkOffset, pending.timestampNs});
+    ++m_framesWritten;
+    return true;
+}
+
+bool FrameRecorder::writeIndex() {
+    RecordingTrailer trailer = {};
+    trailer.indexOffset = m_writeOffset;
+    trailer.frameCount = m_index.size();
+    trailer.magic = kTrailerMagic;
+
+    if (!m_index.empty() &&
+        !writeBytes(m_index.data(), static_cast<qint64>(m_index.size() * sizeof(FrameIndexEntry)))) {
+        return false;
+    }
+    return writeBytes(&trailer, sizeof(trailer));
+}
+
+bool FrameRecorder::writeBytes(const void* data, qint64 size) {
+    if (size == 0) {
+        return true;
+    }
+
+    qint64 written = m_file.write(static_cast<const char*>(data), size);
+    if (written != size) {
+        return false;
+    }
+
+    m_writeOffset += static_cast<quint64>(size);
+    m_bytesWritten += static_cast<quint64>(size);
+    return true;
+}
+
+bool FrameRecorder::writePadding(quint64 alignedOffset) {
+    static const char zeros[kPayloadAlignment] = {};
+    return writeBytes(zeros, static_cast<qint64>(alignedOffset - m_writeOffset));
+}
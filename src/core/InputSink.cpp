@@ -0,0 +1,195 @@
+#include "core/InputSink.h"
+#include <QCoreApplication>
+#include <QCursor>
+#include <QThread>
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// =============================================================================
+// InputSink
+// =============================================================================
+
+void InputSink::click(Qt::MouseButton button) {
+    buttonEvent(button, true);
+    buttonEvent(button, false);
+}
+
+// =============================================================================
+// PlatformInputSink
+// =============================================================================
+
+#ifdef _WIN32
+namespace {
+DWORD buttonFlags(Qt::MouseButton button, bool pressed) {
+    if (button == Qt::RightButton) {
+        return pressed ? MOUSEEVENTF_RIGHTDOWN : MOUSEEVENTF_RIGHTUP;
+    }
+    if (button == Qt::MiddleButton) {
+        return pressed ? MOUSEEVENTF_MIDDLEDOWN : MOUSEEVENTF_MIDDLEUP;
+    }
+    return pressed ? MOUSEEVENTF_LEFTDOWN : MOUSEEVENTF_LEFTUP;
+}
+}
+#else
+namespace {
+quint64 packPosition(int x, int y) {
+    return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
+
+QPoint unpackPosition(quint64 packed) {
+    return QPoint(static_cast<qint32>(packed >> 32), static_cast<qint32>(packed & 0xFFFFFFFFu));
+}
+}
+#endif
+
+PlatformInputSink::PlatformInputSink()
+    : m_pendingMove(std::make_shared<PendingMove>())
+{
+}
+
+void PlatformInputSink::moveAbsolute(int x, int y) {
+#ifdef _WIN32
+    SetCursorPos(x, y);
+#else
+    // QCursor is a GUI-thread API; hand the move over to the application thread
+    QCoreApplication* app = QCoreApplication::instance();
+    if (!app || QThread::currentThread() == app->thread()) {
+        QCursor::setPos(x, y);
+        return;
+    }
+    
+    // The actuation thread moves at up to 1 kHz; a queued call already in
+    // flight picks up the newest position, so no new one is needed
+    m_pendingMove->position.store(packPosition(x, y), std::memory_order_relaxed);
+    if (m_pendingMove->queued.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    
+    std::shared_ptr<PendingMove> pending = m_pendingMove;
+    QMetaObject::invokeMethod(app, [pending]() {
+        // Cleared first, so a move stored after the load queues a new call.
+        // An exchange rather than a store: it acquires the newest position
+        // from whichever mover last found the flag already set.
+        pending->queued.exchange(false, std::memory_order_acq_rel);
+        QPoint position = unpackPosition(pending->position.load(std::memory_order_relaxed));
+        QCursor::setPos(position);
+    }, Qt::QueuedConnection);
+#endif
+}
+
+void PlatformInputSink::moveRelative(int dx, int dy) {
+#ifdef _WIN32
+    INPUT input = {};
+    input.type = INPUT_MOUSE;
+    input.mi.dx = dx;
+    input.mi.dy = dy;
+    input.mi.dwFlags = MOUSEEVENTF_MOVE;
+    SendInput(1, &input, sizeof(INPUT));
+#else
+    // Relative to a move still waiting for the GUI thread, if there is one
+    QPoint current = m_pendingMove->queued.load(std::memory_order_acquire)
+        ? unpackPosition(m_pendingMove->position.load(std::memory_order_relaxed))
+        : cursorPosition();
+    moveAbsolute(current.x() + dx, current.y() + dy);
+#endif
+}
+
+void PlatformInputSink::buttonEvent(Qt::MouseButton button, bool pressed) {
+#ifdef _WIN32
+    INPUT input = {};
+    input.type = INPUT_MOUSE;
+    input.mi.dwFlags = buttonFlags(button, pressed);
+    SendInput(1, &input, sizeof(INPUT));
+#else
+    Q_UNUSED(button);
+    Q_UNUSED(pressed);
+#endif
+}
+
+QPoint PlatformInputSink::cursorPosition() const {
+#ifdef _WIN32
+    POINT point;
+    if (GetCursorPos(&point)) {
+        return QPoint(point.x, point.y);
+    }
+#endif
+    return QCursor::pos();
+}
+
+void PlatformInputSink::click(Qt::MouseButton button) {
+#ifdef _WIN32
+    INPUT inputs[2] = {};
+    inputs[0].type = INPUT_MOUSE;
+    inputs[0].mi.dwFlags = buttonFlags(button, true);
+    inputs[1].type = INPUT_MOUSE;
+    inputs[1].mi.dwFlags = buttonFlags(button, false);
+    SendInput(2, inputs, sizeof(INPUT));
+#else
+    Q_UNUSED(button);
+#endif
+}
+
+// =============================================================================
+// RecordingInputSink
+// =============================================================================
+
+RecordingInputSink::RecordingInputSink(const QPoint& initialPosition)
+    : m_position(initialPosition)
+{
+}
+
+void RecordingInputSink::moveAbsolute(int x, int y) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_position = QPoint(x, y);
+    record(EventType::MoveAbsolute, QPoint(0, 0), Qt::NoButton);
+}
+
+void RecordingInputSink::moveRelative(int dx, int dy) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_position += QPoint(dx, dy);
+    record(EventType::MoveRelative, QPoint(dx, dy), Qt::NoButton);
+}
+
+void RecordingInputSink::buttonEvent(Qt::MouseButton button, bool pressed) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    record(pressed ? EventType::ButtonDown : EventType::ButtonUp, QPoint(0, 0), button);
+}
+
+QPoint RecordingInputSink::cursorPosition() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_position;
+}
+
+std::vector<RecordingInputSink::Event> RecordingInputSink::getEvents() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_events;
+}
+
+size_t RecordingInputSink::getEventCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_events.size();
+}
+
+void RecordingInputSink::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.clear();
+}
+
+void RecordingInputSink::reserve(size_t events) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.reserve(events);
+}
+
+void RecordingInputSink::setCursorPosition(const QPoint& position) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_position = position;
+}
+
+void RecordingInputSink::record(EventType type, const QPoint& delta, Qt::MouseButton button) {
+    qint64 timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    m_events.push_back({type, m_position, delta, button, timestampNs});
+}
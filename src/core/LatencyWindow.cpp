@@ -0,0 +1,50 @@
+#include "core/LatencyWindow.h"
+#include <algorithm>
+
+LatencyWindow::LatencyWindow(size_t capacity)
+    : m_samples(std::max<size_t>(1, capacity), 0.0)
+    , m_next(0)
+    , m_count(0)
+{
+    m_scratch.reserve(m_samples.size());
+}
+
+void LatencyWindow::add(double ms) {
+    m_samples[m_next] = ms;
+    m_next = (m_next + 1) % m_samples.size();
+    m_count = std::min(m_count + 1, m_samples.size());
+}
+
+void LatencyWindow::clear() {
+    m_next = 0;
+    m_count = 0;
+}
+
+size_t LatencyWindow::size() const {
+    return m_count;
+}
+
+size_t LatencyWindow::capacity() const {
+    return m_samples.size();
+}
+
+LatencyPercentiles LatencyWindow::percentiles() const {
+    LatencyPercentiles result;
+    if (m_count == 0) {
+        return result;
+    }
+    
+    // Order doesn't matter for percentiles, so the ring is copied as-is
+    m_scratch.assign(m_samples.begin(), m_samples.begin() + m_count);
+    
+    auto rank = [this](double p) {
+        size_t index = static_cast<size_t>(p * (m_scratch.size() - 1) + 0.5);
+        std::nth_element(m_scratch.begin(), m_scratch.begin() + index, m_scratch.end());
+        return m_scratch[index];
+    };
+    
+    result.p50 = rank(0.50);
+    result.p95 = rank(0.95);
+    result.p99 = rank(0.99);
+    return result;
+}
@@ -0,0 +1,122 @@
+#include "core/MetricsRegistry.h"
+
+namespace {
+const char* const kStageNames[] = {"capture", "detect", "frame"};
+
+struct MetricInfo {
+    const char* name;
+    const char* help;
+};
+
+const MetricInfo kCounterInfo[] = {
+    {"agar_frames_total", "Frames processed by the tracker"},
+    {"agar_targets_detected_total", "Targets detected"},
+    {"agar_assists_total", "Aim assist corrections applied"},
+    {"agar_stale_frames_dropped_total", "Frames dropped before detection for exceeding the max frame age"},
+    {"agar_stale_detections_dropped_total", "Detections dropped before actuation for exceeding the max frame age"},
+    {"agar_frame_buffer_allocations_total", "Capture frame buffers allocated because the previous one was still in use or changed size"},
+    {"agar_process_voluntary_context_switches_total", "Context switches where a thread blocked or yielded"},
+    {"agar_process_involuntary_context_switches_total", "Context switches where a thread was preempted"},
+    {"agar_process_page_faults_total", "Page faults, minor and major"},
+};
+
+const MetricInfo kGaugeInfo[] = {
+    {"agar_fps", "Achieved tracker FPS over the last stats interval"},
+    {"agar_target_fps", "Configured target FPS"},
+    {"agar_governed_fps", "FPS currently allowed by the adaptive governor"},
+    {"agar_detection_quality", "Detection quality level (0 = full)"},
+    {"agar_process_resident_memory_bytes", "Resident set size (working set on Windows)"},
+    {"agar_process_peak_resident_memory_bytes", "Peak resident set size"},
+    {"agar_process_cpu_percent", "Process CPU usage over the last sample, in percent of one core"},
+    {"agar_ui_retranslate_ms", "Duration of the last language switch, relayout included"},
+    {"agar_overlay_paint_ms", "Mean overlay paintEvent duration since the previous rollup"},
+};
+}
+
+const std::array<double, MetricsRegistry::kBucketCount - 1> MetricsRegistry::kBucketBounds = {
+    0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 33.0, 100.0
+};
+
+MetricsRegistry::MetricsRegistry() {
+    for (auto& histogram : m_histograms) {
+        for (auto& bucket : histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.sumNs.store(0, std::memory_order_relaxed);
+    }
+    for (auto& counter : m_counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    for (auto& gauge : m_gauges) {
+        gauge.store(0.0, std::memory_order_relaxed);
+    }
+}
+
+void MetricsRegistry::observe(Stage stage, double ms) {
+    Histogram& histogram = m_histograms[static_cast<size_t>(stage)];
+    
+    // Buckets are stored non-cumulative and summed when rendered
+    int bucket = 0;
+    while (bucket < kBucketCount - 1 && ms > kBucketBounds[bucket]) {
+        ++bucket;
+    }
+    
+    histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.sumNs.fetch_add(static_cast<quint64>(ms * 1e6), std::memory_order_relaxed);
+}
+
+void MetricsRegistry::increment(Counter counter, quint64 amount) {
+    m_counters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::setTotal(Counter counter, quint64 total) {
+    m_counters[static_cast<size_t>(counter)].store(total, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::set(Gauge gauge, double value) {
+    m_gauges[static_cast<size_t>(gauge)].store(value, std::memory_order_relaxed);
+}
+
+QByteArray MetricsRegistry::renderPrometheus() const {
+    QByteArray out;
+    out.reserve(4096);
+    
+    out += "# HELP agar_stage_latency_seconds Pipeline stage latency\n";
+    out += "# TYPE agar_stage_latency_seconds histogram\n";
+    for (size_t stage = 0; stage < m_histograms.size(); ++stage) {
+        const Histogram& histogram = m_histograms[stage];
+        QByteArray label = QByteArray("stage=\"") + kStageNames[stage] + "\"";
+        
+        quint64 cumulative = 0;
+        for (int bucket = 0; bucket < kBucketCount; ++bucket) {
+            cumulative += histogram.buckets[bucket].load(std::memory_order_relaxed);
+            QByteArray le = bucket < kBucketCount - 1
+                ? QByteArray::number(kBucketBounds[bucket] / 1000.0, 'g', 6)
+                : QByteArray("+Inf");
+            out += "agar_stage_latency_seconds_bucket{" + label + ",le=\"" + le + "\"} " +
+                   QByteArray::number(cumulative) + "\n";
+        }
+        out += "agar_stage_latency_seconds_sum{" + label + "} " +
+               QByteArray::number(histogram.sumNs.load(std::memory_order_relaxed) / 1e9, 'f', 6) + "\n";
+        out += "agar_stage_latency_seconds_count{" + label + "} " +
+               QByteArray::number(histogram.count.load(std::memory_order_relaxed)) + "\n";
+    }
+    
+    for (size_t i = 0; i < m_counters.size(); ++i) {
+        out += QByteArray("# HELP ") + kCounterInfo[i].name + " " + kCounterInfo[i].help + "\n";
+        out += QByteArray("# TYPE ") + kCounterInfo[i].name + " counter\n";
+        out += QByteArray(kCounterInfo[i].name) + " " +
+               QByteArray::number(m_counters[i].load(std::memory_order_relaxed)) + "\n";
+    }
+    
+    for (size_t i = 0; i < m_gauges.size(); ++i) {
+        out += QByteArray("# HELP ") + kGaugeInfo[i].name + " " + kGaugeInfo[i].help + "\n";
+        out += QByteArray("# TYPE ") + kGaugeInfo[i].name + " gauge\n";
+        out += QByteArray(kGaugeInfo[i].name) + " " +
+               QByteArray::number(m_gauges[i].load(std::memory_order_relaxed), 'g', 10) + "\n";
+    }
+    
+    return out;
+}
@@ -1,11 +1,20 @@
 #include "core/MouseController.h"
-#include <QCursor>
-#include <QGuiApplication>
-#include <QScreen>
+#include "core/ResourceMonitor.h"
 #include <algorithm>
+#include <climits>
 #include <cmath>
 #include <chrono>
 
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#endif
+
+namespace {
+// Actuation thread wake-up period; positions come from the clock, not ticks
+constexpr auto kActuationTick = std::chrono::milliseconds(1);
+}
+
 MouseController::MouseController(QObject* parent)
     : QObject(parent)
     , m_aimAssistStrength(30)
@@ -13,18 +22,26 @@ MouseController::MouseController(QObject* parent)
     , m_isMoving(false)
     , m_humanizeEnabled(true)
     , m_randomizationFactor(0.3)
-    , m_pathIndex(0)
+    , m_pathDuration(0)
+    , m_pathGeneration(0)
+    , m_pathActive(false)
+    , m_stopActuation(false)
+    , m_inputSink(std::make_shared<PlatformInputSink>())
     , m_rng(std::chrono::steady_clock::now().time_since_epoch().count())
     , m_distribution(0.0, 1.0)
 {
-    m_movementTimer = new QTimer(this);
-    m_movementTimer->setInterval(1); // 1ms for smooth movement
-    connect(m_movementTimer, &QTimer::timeout, this, &MouseController::onMovementTick);
+    m_actuationThread = std::thread(&MouseController::actuationLoop, this);
 }
 
 MouseController::~MouseController() {
-    if (m_movementTimer->isActive()) {
-        m_movementTimer->stop();
+    {
+        std::lock_guard<std::mutex> lock(m_pathMutex);
+        m_stopActuation = true;
+    }
+    m_pathCondition.notify_one();
+    
+    if (m_actuationThread.joinable()) {
+        m_actuationThread.join();
     }
 }
 
@@ -60,8 +77,22 @@ double MouseController::getRandomizationFactor() const {
     return m_randomizationFactor;
 }
 
+void MouseController::setInputSink(std::shared_ptr<InputSink> sink) {
+    if (!sink) {
+        sink = std::make_shared<PlatformInputSink>();
+    }
+    
+    std::lock_guard<std::mutex> lock(m_pathMutex);
+    m_inputSink = std::move(sink);
+}
+
+std::shared_ptr<InputSink> MouseController::getInputSink() const {
+    std::lock_guard<std::mutex> lock(m_pathMutex);
+    return m_inputSink;
+}
+
 QPoint MouseController::getCurrentPosition() const {
-    return QCursor::pos();
+    return getInputSink()->cursorPosition();
 }
 
 bool MouseController::isMoving() const {
@@ -153,36 +184,41 @@ void MouseController::addMicroMovements(std::vector<BezierPoint>& path) {
 }
 
 void MouseController::moveToTarget(const QPoint& target) {
-    platformMove(target.x(), target.y());
+    getInputSink()->moveAbsolute(target.x(), target.y());
     emit positionChanged(target);
 }
 
 void MouseController::moveSmoothly(const QPoint& target, int durationMs) {
-    if (m_isMoving) {
-        m_movementTimer->stop();
-    }
-    
     QPoint start = getCurrentPosition();
     
-    // Calculate number of steps based on duration and timer interval
-    int steps = std::max(10, durationMs / m_movementTimer->interval());
+    // One path point per millisecond of playback
+    int steps = std::max(10, durationMs);
     
-    m_currentPath = generateBezierPath(start, target, steps);
+    std::vector<BezierPoint> path = generateBezierPath(start, target, steps);
     
     if (m_humanizeEnabled) {
-        addMicroMovements(m_currentPath);
+        addMicroMovements(path);
     }
     
-    m_pathIndex = 0;
     m_targetPosition = target;
-    m_isMoving = true;
     
+    {
+        // A new path replaces whatever is currently playing
+        std::lock_guard<std::mutex> lock(m_pathMutex);
+        m_currentPath = std::move(path);
+        m_pathStart = std::chrono::steady_clock::now();
+        m_pathDuration = std::chrono::milliseconds(std::max(1, durationMs));
+        ++m_pathGeneration;
+        m_pathActive = true;
+    }
+    
+    m_isMoving = true;
     emit movementStarted();
-    m_movementTimer->start();
+    m_pathCondition.notify_one();
 }
 
 void MouseController::moveRelative(int dx, int dy) {
-    platformMoveRelative(dx, dy);
+    getInputSink()->moveRelative(dx, dy);
     emit positionChanged(getCurrentPosition());
 }
 
@@ -223,80 +259,114 @@ void MouseController::applyAimAssist(const QPoint& targetPos) {
     }
 }
 
-void MouseController::onMovementTick() {
-    if (m_pathIndex >= static_cast<int>(m_currentPath.size())) {
-        m_movementTimer->stop();
-        m_isMoving = false;
-        emit movementCompleted();
-        return;
+BezierPoint MouseController::samplePath(const std::vector<BezierPoint>& path, double t) {
+    if (path.size() == 1) {
+        return path.front();
     }
     
-    const BezierPoint& point = m_currentPath[m_pathIndex];
-    platformMove(static_cast<int>(point.x), static_cast<int>(point.y));
+    // Path points are evenly spaced in t; interpolate between neighbours
+    double position = std::clamp(t, 0.0, 1.0) * (path.size() - 1);
+    size_t index = std::min(static_cast<size_t>(position), path.size() - 2);
+    double fraction = position - index;
     
-    emit positionChanged(QPoint(static_cast<int>(point.x), static_cast<int>(point.y)));
-    
-    ++m_pathIndex;
+    const BezierPoint& a = path[index];
+    const BezierPoint& b = path[index + 1];
+    return {a.x + (b.x - a.x) * fraction, a.y + (b.y - a.y) * fraction};
 }
 
-void MouseController::platformMove(int x, int y) {
+void MouseController::actuationLoop() {
+    ResourceMonitor::setCurrentThreadName("MouseActuation");
+    
 #ifdef _WIN32
-    SetCursorPos(x, y);
-#else
-    QCursor::setPos(x, y);
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
 #endif
-}
-
-void MouseController::platformMoveRelative(int dx, int dy) {
+    
+    // Default Windows timer granularity is ~15.6 ms. 1 ms is requested only
+    // while a path is being played: it is system-wide and costs power, so
+    // it is released before every idle wait.
+    bool fineTimer = false;
+    auto setFineTimer = [&fineTimer](bool enabled) {
+        if (enabled == fineTimer) {
+            return;
+        }
+        fineTimer = enabled;
 #ifdef _WIN32
-    INPUT input = {};
-    input.type = INPUT_MOUSE;
-    input.mi.dx = dx;
-    input.mi.dy = dy;
-    input.mi.dwFlags = MOUSEEVENTF_MOVE;
-    SendInput(1, &input, sizeof(INPUT));
-#else
-    QPoint current = QCursor::pos();
-    QCursor::setPos(current.x() + dx, current.y() + dy);
+        if (enabled) {
+            timeBeginPeriod(1);
+        } else {
+            timeEndPeriod(1);
+        }
 #endif
+    };
+    
+    std::unique_lock<std::mutex> lock(m_pathMutex);
+    QPoint lastPosition(INT_MIN, INT_MIN);
+    
+    while (!m_stopActuation) {
+        if (!m_pathActive || m_currentPath.empty()) {
+            setFineTimer(false);
+            m_pathCondition.wait(lock, [this]() {
+                return m_stopActuation || (m_pathActive && !m_currentPath.empty());
+            });
+            continue;
+        }
+        
+        setFineTimer(true);
+        auto now = std::chrono::steady_clock::now();
+        double t = std::chrono::duration<double>(now - m_pathStart).count() /
+                   std::chrono::duration<double>(m_pathDuration).count();
+        bool finished = t >= 1.0;
+        
+        BezierPoint point = samplePath(m_currentPath, t);
+        quint64 generation = m_pathGeneration;
+        std::shared_ptr<InputSink> sink = m_inputSink;
+        if (finished) {
+            m_pathActive = false;
+        }
+        
+        lock.unlock();
+        
+        QPoint position(static_cast<int>(point.x), static_cast<int>(point.y));
+        if (position != lastPosition) {
+            sink->moveAbsolute(position.x(), position.y());
+            lastPosition = position;
+            emit positionChanged(position);
+        }
+        
+        lock.lock();
+        
+        if (finished) {
+            // Only report completion if no newer path was queued meanwhile
+            if (generation == m_pathGeneration) {
+                m_isMoving = false;
+                lock.unlock();
+                emit movementCompleted();
+                lock.lock();
+            }
+            continue;
+        }
+        
+        // Sleep until the next tick, waking early for a new path or shutdown
+        m_pathCondition.wait_until(lock, now + kActuationTick, [this, generation]() {
+            return m_stopActuation || m_pathGeneration != generation;
+        });
+    }
+    
+    setFineTimer(false);
 }
 
 void MouseController::leftClick() {
-#ifdef _WIN32
-    INPUT inputs[2] = {};
-    inputs[0].type = INPUT_MOUSE;
-    inputs[0].mi.dwFlags = MOUSEEVENTF_LEFTDOWN;
-    inputs[1].type = INPUT_MOUSE;
-    inputs[1].mi.dwFlags = MOUSEEVENTF_LEFTUP;
-    SendInput(2, inputs, sizeof(INPUT));
-#endif
+    getInputSink()->click(Qt::LeftButton);
 }
 
 void MouseController::rightClick() {
-#ifdef _WIN32
-    INPUT inputs[2] = {};
-    inputs[0].type = INPUT_MOUSE;
-    inputs[0].mi.dwFlags = MOUSEEVENTF_RIGHTDOWN;
-    inputs[1].type = INPUT_MOUSE;
-    inputs[1].mi.dwFlags = MOUSEEVENTF_RIGHTUP;
-    SendInput(2, inputs, sizeof(INPUT));
-#endif
+    getInputSink()->click(Qt::RightButton);
 }
 
 void MouseController::leftDown() {
-#ifdef _WIN32
-    INPUT input = {};
-    input.type = INPUT_MOUSE;
-    input.mi.dwFlags = MOUSEEVENTF_LEFTDOWN;
-    SendInput(1, &input, sizeof(INPUT));
-#endif
+    getInputSink()->buttonEvent(Qt::LeftButton, true);
 }
 
 void MouseController::leftUp() {
-#ifdef _WIN32
-    INPUT input = {};
-    input.type = INPUT_MOUSE;
-    input.mi.dwFlags = MOUSEEVENTF_LEFTUP;
-    SendInput(1, &input, sizeof(INPUT));
-#endif
+    getInputSink()->buttonEvent(Qt::LeftButton, false);
 }
@@ -1,8 +1,23 @@
 #include "core/Overlay.h"
 #include <QGuiApplication>
 #include <QScreen>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QFontDatabase>
+#include <QFontMetrics>
 #include <algorithm>
 
+namespace {
+// Room around the FOV ring for its pen and for boxes straddling the edge
+constexpr int kFOVGeometryMargin = 16;
+
+// HUD panel layout
+constexpr int kHudLines = 6;
+constexpr int kHudColumns = 40;
+constexpr int kHudPadding = 6;
+constexpr int kHudGap = 12;
+}
+
 #ifdef _WIN32
 #include <dwmapi.h>
 #pragma comment(lib, "dwmapi.lib")
@@ -14,38 +29,57 @@ Overlay::Overlay(QWidget* parent)
     , m_fovColor(QColor(0, 255, 0, 128))
     , m_fovVisible(true)
     , m_targetIndicatorVisible(true)
+    , m_targetFeed(nullptr)
     , m_crosshairVisible(false)
     , m_crosshairColor(QColor(255, 0, 0, 200))
     , m_crosshairSize(20)
     , m_overlayEnabled(true)
+    , m_fovOnlyGeometry(true)
+    , m_layerCachingEnabled(true)
+    , m_fovLayerDirty(true)
+    , m_crosshairLayerDirty(true)
+    , m_lastPaintTime(0.0)
+    , m_paintTimeSum(0.0)
+    , m_paintCount(0)
+    , m_hudVisible(false)
+    , m_hudLayerDirty(true)
+    , m_hudFormats({"FPS     %1 / %2 (gov %3)",
+                    "Capture p50 %1  p95 %2 ms",
+                    "Detect  p50 %1  p95 %2 ms",
+                    "Frame   p50 %1  p95 %2  p99 %3",
+                    "Dropped %1 frames, %2 detections",
+                    "Targets %1 on screen, %2 total"})
 {
-    setupOverlayWindow();
+    // HUD text is fixed-width so its panel never changes size
+    m_hudFont = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    m_hudFont.setPointSize(9);
+    QFontMetrics metrics(m_hudFont);
+    m_hudSize = QSize(metrics.horizontalAdvance(QString(kHudColumns, QChar('0'))) + kHudPadding * 2,
+                      metrics.lineSpacing() * kHudLines + kHudPadding * 2);
     
-    m_refreshTimer = new QTimer(this);
-    m_refreshTimer->setInterval(16); // ~60 FPS refresh
-    connect(m_refreshTimer, &QTimer::timeout, this, &Overlay::refresh);
+    // Sampling the HUD is the only periodic work; the overlay otherwise only
+    // repaints when its state changes
+    m_hudTimer = new QTimer(this);
+    m_hudTimer->setInterval(250);
+    connect(m_hudTimer, &QTimer::timeout, this, &Overlay::refreshHUD);
+    
+    setupOverlayWindow();
 }
 
 Overlay::~Overlay() {
-    if (m_refreshTimer->isActive()) {
-        m_refreshTimer->stop();
-    }
+    setTargetFeed(nullptr);
 }
 
 void Overlay::setupOverlayWindow() {
     setAttribute(Qt::WA_TranslucentBackground);
     setAttribute(Qt::WA_TransparentForMouseEvents);
     setAttribute(Qt::WA_ShowWithoutActivating);
-    
+
 #ifdef _WIN32
     makeClickThrough();
 #endif
-    
-    // Set to full screen
-    QScreen* screen = QGuiApplication::primaryScreen();
-    if (screen) {
-        setGeometry(screen->geometry());
-    }
+
+    updatePosition();
 }
 
 #ifdef _WIN32
@@ -62,8 +96,26 @@ void Overlay::makeClickThrough() {
 #endif
 
 void Overlay::setFOVRadius(int radius) {
-    m_fovRadius = std::clamp(radius, 50, 500);
-    update();
+    radius = std::clamp(radius, 50, 500);
+    if (radius == m_fovRadius) {
+        return;
+    }
+    
+    QRect oldRect = fovRect();
+    QRect oldHud = hudRect().translated(fovCenter());
+    m_fovRadius = radius;
+    m_fovLayerDirty = true;
+    if (m_fovOnlyGeometry) {
+        // Resizing repaints everything anyway
+        updatePosition();
+    } else {
+        if (m_fovVisible) {
+            update(oldRect.united(fovRect()));
+        }
+        if (m_hudVisible) {
+            update(oldHud.united(hudRect().translated(fovCenter())));
+        }
+    }
 }
 
 int Overlay::getFOVRadius() const {
@@ -71,8 +123,15 @@ int Overlay::getFOVRadius() const {
 }
 
 void Overlay::setFOVColor(const QColor& color) {
+    if (color == m_fovColor) {
+        return;
+    }
+    
     m_fovColor = color;
-    update();
+    m_fovLayerDirty = true;
+    if (m_fovVisible) {
+        update(fovRect());
+    }
 }
 
 QColor Overlay::getFOVColor() const {
@@ -80,8 +139,12 @@ QColor Overlay::getFOVColor() const {
 }
 
 void Overlay::setFOVVisible(bool visible) {
+    if (visible == m_fovVisible) {
+        return;
+    }
+    
     m_fovVisible = visible;
-    update();
+    update(fovRect());
 }
 
 bool Overlay::isFOVVisible() const {
@@ -89,18 +152,72 @@ bool Overlay::isFOVVisible() const {
 }
 
 void Overlay::setTargets(const std::vector<OverlayTarget>& targets) {
-    m_targets = targets;
-    update();
+    // Map into widget coordinates; the buffer keeps its capacity between calls
+    m_incomingTargets = targets;
+    for (auto& target : m_incomingTargets) {
+        target.position = mapFromDesktop(target.position);
+        target.boundingBox = mapFromDesktop(target.boundingBox);
+    }
+    
+    if (m_incomingTargets == m_targets) {
+        return;
+    }
+    
+    // Repaint only where boxes were and where they are now
+    QRegion dirty = targetsRegion(m_targets).united(targetsRegion(m_incomingTargets));
+    m_targets.swap(m_incomingTargets);
+    if (m_targetIndicatorVisible) {
+        update(dirty);
+    }
 }
 
 void Overlay::clearTargets() {
+    if (m_targets.empty()) {
+        return;
+    }
+    
+    QRegion dirty = targetsRegion(m_targets);
     m_targets.clear();
-    update();
+    if (m_targetIndicatorVisible) {
+        update(dirty);
+    }
+}
+
+void Overlay::setTargetFeed(TargetFeed* feed) {
+    if (m_targetFeed) {
+        m_targetFeed->setNotifier(nullptr);
+    }
+    
+    m_targetFeed = feed;
+    
+    if (m_targetFeed) {
+        // Posted from the pipeline; the feed coalesces so at most one is queued
+        QPointer<Overlay> self(this);
+        m_targetFeed->setNotifier([self]() {
+            if (self) {
+                QMetaObject::invokeMethod(self, "onTargetsPublished", Qt::QueuedConnection);
+            }
+        });
+        onTargetsPublished();
+    }
+}
+
+void Overlay::onTargetsPublished() {
+    if (!m_targetFeed || !m_targetFeed->acquire()) {
+        return;
+    }
+    
+    // Copy-assigning into m_targets reuses its capacity
+    setTargets(m_targetFeed->readBuffer().targets);
 }
 
 void Overlay::setTargetIndicatorVisible(bool visible) {
+    if (visible == m_targetIndicatorVisible) {
+        return;
+    }
+    
     m_targetIndicatorVisible = visible;
-    update();
+    update(targetsRegion(m_targets));
 }
 
 bool Overlay::isTargetIndicatorVisible() const {
@@ -108,8 +225,12 @@ bool Overlay::isTargetIndicatorVisible() const {
 }
 
 void Overlay::setCrosshairVisible(bool visible) {
+    if (visible == m_crosshairVisible) {
+        return;
+    }
+    
     m_crosshairVisible = visible;
-    update();
+    update(crosshairRect());
 }
 
 bool Overlay::isCrosshairVisible() const {
@@ -117,8 +238,15 @@ bool Overlay::isCrosshairVisible() const {
 }
 
 void Overlay::setCrosshairColor(const QColor& color) {
+    if (color == m_crosshairColor) {
+        return;
+    }
+    
     m_crosshairColor = color;
-    update();
+    m_crosshairLayerDirty = true;
+    if (m_crosshairVisible) {
+        update(crosshairRect());
+    }
 }
 
 QColor Overlay::getCrosshairColor() const {
@@ -126,8 +254,17 @@ QColor Overlay::getCrosshairColor() const {
 }
 
 void Overlay::setCrosshairSize(int size) {
-    m_crosshairSize = std::clamp(size, 5, 100);
-    update();
+    size = std::clamp(size, 5, 100);
+    if (size == m_crosshairSize) {
+        return;
+    }
+    
+    QRect oldRect = crosshairRect();
+    m_crosshairSize = size;
+    m_crosshairLayerDirty = true;
+    if (m_crosshairVisible) {
+        update(oldRect.united(crosshairRect()));
+    }
 }
 
 int Overlay::getCrosshairSize() const {
@@ -139,10 +276,14 @@ void Overlay::setOverlayEnabled(bool enabled) {
     
     if (enabled) {
         show();
-        m_refreshTimer->start();
     } else {
         hide();
-        m_refreshTimer->stop();
+    }
+    
+    if (m_hudVisible && enabled) {
+        m_hudTimer->start();
+    } else {
+        m_hudTimer->stop();
     }
 }
 
@@ -151,47 +292,335 @@ bool Overlay::isOverlayEnabled() const {
 }
 
 void Overlay::updatePosition() {
+    QRect target = overlayGeometry();
+    if (target.isEmpty() || target == geometry()) {
+        return;
+    }
+    
+    // Boxes were mapped against the old origin; the next snapshot brings fresh ones
+    m_targets.clear();
+    setGeometry(target);
+}
+
+void Overlay::setCaptureMonitor(const QRect& geometry) {
+    m_monitorGeometry = geometry;
+    updatePosition();
+}
+
+QRect Overlay::getCaptureMonitor() const {
+    return m_monitorGeometry;
+}
+
+void Overlay::setFOVOnlyGeometry(bool enabled) {
+    if (enabled == m_fovOnlyGeometry) {
+        return;
+    }
+    
+    m_fovOnlyGeometry = enabled;
+    updatePosition();
+}
+
+bool Overlay::isFOVOnlyGeometry() const {
+    return m_fovOnlyGeometry;
+}
+
+QRect Overlay::monitorRect() const {
+    if (!m_monitorGeometry.isEmpty()) {
+        return m_monitorGeometry;
+    }
+    
     QScreen* screen = QGuiApplication::primaryScreen();
-    if (screen) {
-        setGeometry(screen->geometry());
+    return screen ? screen->geometry() : QRect();
+}
+
+QPoint Overlay::desktopCenter() const {
+    QRect monitor = monitorRect();
+    return monitor.topLeft() + QPoint(monitor.width() / 2, monitor.height() / 2);
+}
+
+QPoint Overlay::fovCenter() const {
+    return mapFromDesktop(desktopCenter());
+}
+
+QRect Overlay::overlayGeometry() const {
+    QRect monitor = monitorRect();
+    if (monitor.isEmpty() || !m_fovOnlyGeometry) {
+        return monitor;
     }
+    
+    // Detection never looks outside the FOV, so neither does the overlay
+    int extent = std::max(m_fovRadius, m_crosshairSize / 2) + kFOVGeometryMargin;
+    QPoint center = desktopCenter();
+    QRect area(center.x() - extent, center.y() - extent, extent * 2, extent * 2);
+    
+    if (m_hudVisible) {
+        area = area.united(hudRect().translated(center));
+    }
+    
+    return area.intersected(monitor);
 }
 
-void Overlay::refresh() {
+QPoint Overlay::mapFromDesktop(const QPoint& point) const {
+    return point - geometry().topLeft();
+}
+
+QRect Overlay::mapFromDesktop(const QRect& rect) const {
+    return rect.translated(-geometry().topLeft());
+}
+
+void Overlay::setLayerCachingEnabled(bool enabled) {
+    if (enabled == m_layerCachingEnabled) {
+        return;
+    }
+    
+    m_layerCachingEnabled = enabled;
+    m_fovLayer = QPixmap();
+    m_crosshairLayer = QPixmap();
+    m_fovLayerDirty = true;
+    m_crosshairLayerDirty = true;
     update();
 }
 
-void Overlay::showEvent(QShowEvent* event) {
-    QWidget::showEvent(event);
-    m_refreshTimer->start();
+bool Overlay::isLayerCachingEnabled() const {
+    return m_layerCachingEnabled;
 }
 
-void Overlay::paintEvent(QPaintEvent* event) {
-    Q_UNUSED(event);
+double Overlay::getLastPaintTime() const {
+    return m_lastPaintTime;
+}
+
+double Overlay::getAveragePaintTime() const {
+    return m_paintCount > 0 ? m_paintTimeSum / m_paintCount : 0.0;
+}
+
+int Overlay::getPaintCount() const {
+    return m_paintCount;
+}
+
+void Overlay::resetPaintStats() {
+    m_lastPaintTime = 0.0;
+    m_paintTimeSum = 0.0;
+    m_paintCount = 0;
+}
+
+void Overlay::setHUDVisible(bool visible) {
+    if (visible == m_hudVisible) {
+        return;
+    }
     
-    if (!m_overlayEnabled) {
+    m_hudVisible = visible;
+    
+    if (m_hudVisible && m_overlayEnabled) {
+        refreshHUD();
+        m_hudTimer->start();
+    } else {
+        m_hudTimer->stop();
+    }
+    
+    // The panel sits below the FOV, which may grow or shrink the window
+    updatePosition();
+    update(hudRect().translated(fovCenter()));
+}
+
+bool Overlay::isHUDVisible() const {
+    return m_hudVisible;
+}
+
+void Overlay::setHUDStatsProvider(std::function<PipelineStats()> provider) {
+    m_hudStatsProvider = std::move(provider);
+}
+
+void Overlay::setHUDFormats(const QStringList& formats) {
+    if (formats.size() != kHudLines || formats == m_hudFormats) {
         return;
     }
     
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
+    m_hudFormats = formats;
+    m_hudText.clear();
+    refreshHUD();
+}
+
+void Overlay::refreshHUD() {
+    if (!m_hudVisible || !m_hudStatsProvider) {
+        return;
+    }
     
-    if (m_fovVisible) {
-        drawFOVCircle(painter);
+    PipelineStats stats = m_hudStatsProvider();
+    
+    QString text = m_hudFormats[0]
+                       .arg(stats.fps, 0, 'f', 1).arg(stats.targetFPS).arg(stats.governedFPS) + '\n'
+                 + m_hudFormats[1]
+                       .arg(stats.captureLatency.p50, 5, 'f', 2)
+                       .arg(stats.captureLatency.p95, 5, 'f', 2) + '\n'
+                 + m_hudFormats[2]
+                       .arg(stats.detectLatency.p50, 5, 'f', 2)
+                       .arg(stats.detectLatency.p95, 5, 'f', 2) + '\n'
+                 + m_hudFormats[3]
+                       .arg(stats.frameLatency.p50, 5, 'f', 2)
+                       .arg(stats.frameLatency.p95, 5, 'f', 2)
+                       .arg(stats.frameLatency.p99, 5, 'f', 2) + '\n'
+                 + m_hudFormats[4]
+                       .arg(stats.staleFramesDropped).arg(stats.staleDetectionsDropped) + '\n'
+                 + m_hudFormats[5]
+                       .arg(static_cast<int>(m_targets.size())).arg(stats.totalTargets);
+    
+    // Unchanged text costs neither a re-render nor a repaint
+    if (text == m_hudText) {
+        return;
     }
     
-    if (m_targetIndicatorVisible) {
-        drawTargets(painter);
+    m_hudText = text;
+    m_hudLayerDirty = true;
+    update(hudRect().translated(fovCenter()));
+}
+
+void Overlay::refresh() {
+    update();
+}
+
+void Overlay::paintEvent(QPaintEvent* event) {
+    if (!m_overlayEnabled) {
+        return;
     }
     
-    if (m_crosshairVisible) {
-        drawCrosshair(painter);
+    // The painter is clipped to the dirty region; also skip whole elements
+    // that don't touch it
+    QRect dirty = event->rect();
+    QPoint center = fovCenter();
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    {
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+        
+        if (m_fovVisible && dirty.intersects(fovRect())) {
+            if (m_layerCachingEnabled) {
+                drawFOVLayer(painter);
+            } else {
+                drawFOVCircle(painter, center);
+            }
+        }
+        
+        // Targets move every frame, so they're always drawn live
+        if (m_targetIndicatorVisible) {
+            drawTargets(painter, event->region());
+        }
+        
+        if (m_crosshairVisible && dirty.intersects(crosshairRect())) {
+            if (m_layerCachingEnabled) {
+                drawCrosshairLayer(painter);
+            } else {
+                drawCrosshair(painter, center);
+            }
+        }
+        
+        if (m_hudVisible && dirty.intersects(hudRect().translated(center))) {
+            drawHUDLayer(painter);
+        }
+    }
+    
+    m_lastPaintTime = timer.nsecsElapsed() / 1000000.0;
+    m_paintTimeSum += m_lastPaintTime;
+    ++m_paintCount;
+}
+
+QPixmap Overlay::renderLayer(const QSize& size, void (Overlay::*draw)(QPainter&, const QPoint&)) {
+    // Rasterise at device resolution so the blit is 1:1 on high-DPI screens
+    qreal dpr = devicePixelRatioF();
+    QPixmap layer(size * dpr);
+    layer.setDevicePixelRatio(dpr);
+    layer.fill(Qt::transparent);
+    
+    QPainter painter(&layer);
+    painter.setRenderHint(QPainter::Antialiasing);
+    (this->*draw)(painter, QPoint(size.width() / 2, size.height() / 2));
+    
+    return layer;
+}
+
+void Overlay::drawFOVLayer(QPainter& painter) {
+    QRect rect = fovRect();
+    if (m_fovLayerDirty || m_fovLayer.isNull() ||
+        !qFuzzyCompare(m_fovLayer.devicePixelRatio(), devicePixelRatioF())) {
+        m_fovLayer = renderLayer(rect.size(), &Overlay::drawFOVCircle);
+        m_fovLayerDirty = false;
+    }
+    painter.drawPixmap(rect.topLeft(), m_fovLayer);
+}
+
+void Overlay::drawCrosshairLayer(QPainter& painter) {
+    QRect rect = crosshairRect();
+    if (m_crosshairLayerDirty || m_crosshairLayer.isNull() ||
+        !qFuzzyCompare(m_crosshairLayer.devicePixelRatio(), devicePixelRatioF())) {
+        m_crosshairLayer = renderLayer(rect.size(), &Overlay::drawCrosshair);
+        m_crosshairLayerDirty = false;
+    }
+    painter.drawPixmap(rect.topLeft(), m_crosshairLayer);
+}
+
+QRect Overlay::fovRect() const {
+    QPoint center = fovCenter();
+    int extent = m_fovRadius + 2;
+    return QRect(center.x() - extent, center.y() - extent, extent * 2 + 1, extent * 2 + 1);
+}
+
+QRect Overlay::crosshairRect() const {
+    QPoint center = fovCenter();
+    int extent = std::max(m_crosshairSize / 2, 3) + 2;
+    return QRect(center.x() - extent, center.y() - extent, extent * 2 + 1, extent * 2 + 1);
+}
+
+QRect Overlay::hudRect() const {
+    // Relative to the FOV centre: centred just below the ring
+    return QRect(QPoint(-m_hudSize.width() / 2, m_fovRadius + kHudGap), m_hudSize);
+}
+
+QRect Overlay::targetRect(const OverlayTarget& target) const {
+    const int markerSize = 5;
+    QRect marker(target.position.x() - markerSize, target.position.y() - markerSize,
+                 markerSize * 2 + 1, markerSize * 2 + 1);
+    return target.boundingBox.united(marker).adjusted(-2, -2, 2, 2);
+}
+
+QRegion Overlay::targetsRegion(const std::vector<OverlayTarget>& targets) const {
+    QRegion region;
+    for (const auto& target : targets) {
+        region += targetRect(target);
     }
+    return region;
 }
 
-void Overlay::drawFOVCircle(QPainter& painter) {
-    QPoint center(width() / 2, height() / 2);
+void Overlay::drawHUDLayer(QPainter& painter) {
+    QRect rect = hudRect().translated(fovCenter());
+    
+    if (m_hudLayerDirty || m_hudLayer.isNull() ||
+        !qFuzzyCompare(m_hudLayer.devicePixelRatio(), devicePixelRatioF())) {
+        qreal dpr = devicePixelRatioF();
+        m_hudLayer = QPixmap(rect.size() * dpr);
+        m_hudLayer.setDevicePixelRatio(dpr);
+        m_hudLayer.fill(Qt::transparent);
+        
+        QPainter layerPainter(&m_hudLayer);
+        layerPainter.setRenderHint(QPainter::Antialiasing);
+        layerPainter.setPen(Qt::NoPen);
+        layerPainter.setBrush(QColor(0, 0, 0, 160));
+        layerPainter.drawRoundedRect(QRect(QPoint(0, 0), rect.size()), 4, 4);
+        
+        layerPainter.setFont(m_hudFont);
+        layerPainter.setPen(QColor(220, 220, 220));
+        layerPainter.drawText(QRect(QPoint(0, 0), rect.size()).adjusted(kHudPadding, kHudPadding,
+                                                                        -kHudPadding, -kHudPadding),
+                              Qt::AlignLeft | Qt::AlignTop, m_hudText);
+        
+        m_hudLayerDirty = false;
+    }
     
+    painter.drawPixmap(rect.topLeft(), m_hudLayer);
+}
+
+void Overlay::drawFOVCircle(QPainter& painter, const QPoint& center) {
     // Draw FOV circle outline
     QPen pen(m_fovColor);
     pen.setWidth(2);
@@ -201,8 +630,12 @@ void Overlay::drawFOVCircle(QPainter& painter) {
     painter.drawEllipse(center, m_fovRadius, m_fovRadius);
 }
 
-void Overlay::drawTargets(QPainter& painter) {
+void Overlay::drawTargets(QPainter& painter, const QRegion& dirty) {
     for (const auto& target : m_targets) {
+        if (!dirty.intersects(targetRect(target))) {
+            continue;
+        }
+        
         QColor color = target.isSelected ? QColor(255, 255, 0, 200) : target.color;
         
         QPen pen(color);
@@ -222,9 +655,7 @@ void Overlay::drawTargets(QPainter& painter) {
     }
 }
 
-void Overlay::drawCrosshair(QPainter& painter) {
-    QPoint center(width() / 2, height() / 2);
-    
+void Overlay::drawCrosshair(QPainter& painter, const QPoint& center) {
     QPen pen(m_crosshairColor);
     pen.setWidth(2);
     painter.setPen(pen);
@@ -0,0 +1,333 @@
+#include "core/ResourceMonitor.h"
+#include <QDateTime>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <tlhelp32.h>
+#include <psapi.h>
+#else
+#include <pthread.h>
+#include <sys/resource.h>
+#endif
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+qint64 steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef _WIN32
+// Thread descriptions need Windows 10 1607; resolve them at runtime so
+// older systems simply go without names
+using GetThreadDescriptionFn = HRESULT (WINAPI*)(HANDLE, PWSTR*);
+using SetThreadDescriptionFn = HRESULT (WINAPI*)(HANDLE, PCWSTR);
+
+template<typename Fn>
+Fn kernel32Function(const char* name) {
+    HMODULE kernel32 = GetModuleHandleW(L"kernel32.dll");
+    return kernel32 ? reinterpret_cast<Fn>(GetProcAddress(kernel32, name)) : nullptr;
+}
+
+qint64 fileTimeUs(const FILETIME& time) {
+    ULARGE_INTEGER value;
+    value.LowPart = time.dwLowDateTime;
+    value.HighPart = time.dwHighDateTime;
+    return static_cast<qint64>(value.QuadPart / 10); // 100 ns units
+}
+#endif
+
+#ifdef __linux__
+// Reads a small /proc file into a caller-provided buffer; /proc files report
+// a size of 0, so read until EOF. Returns false if the file couldn't be opened.
+bool readProcFile(const char* path, char* buffer, size_t size) {
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    
+    size_t total = 0;
+    while (total < size - 1) {
+        ssize_t count = ::read(fd, buffer + total, size - 1 - total);
+        if (count <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(count);
+    }
+    ::close(fd);
+    
+    buffer[total] = '\0';
+    return total > 0;
+}
+
+// Numeric value of a "Key:    123 kB" line in a /proc status file. The key
+// has to start a line: "voluntary_ctxt_switches" is also a suffix of
+// "nonvoluntary_ctxt_switches".
+quint64 statusField(const char* status, const char* key) {
+    size_t keyLength = std::strlen(key);
+    for (const char* line = status; line && *line; ) {
+        if (std::strncmp(line, key, keyLength) == 0) {
+            return std::strtoull(line + keyLength, nullptr, 10);
+        }
+        line = std::strchr(line, '\n');
+        if (line) {
+            ++line;
+        }
+    }
+    return 0;
+}
+
+struct TaskStat {
+    const char* name;
+    int nameLength;
+    qint64 cpuTimeUs;
+};
+
+// Parses /proc/<pid>/task/<tid>/stat. The command name is in parentheses
+// and may itself contain spaces or parentheses, so fields are counted from
+// the last ')'.
+bool parseTaskStat(const char* stat, TaskStat& out) {
+    const char* open = std::strchr(stat, '(');
+    const char* close = std::strrchr(stat, ')');
+    if (!open || !close || close < open) {
+        return false;
+    }
+    
+    out.name = open + 1;
+    out.nameLength = static_cast<int>(close - open - 1);
+    
+    // Field 3 (state) follows the name; utime and stime are fields 14 and 15
+    const char* cursor = close + 1;
+    qint64 utime = 0, stime = 0;
+    for (int field = 3; field <= 15 && *cursor; ++field) {
+        while (*cursor == ' ') {
+            ++cursor;
+        }
+        long long value = std::strtoll(cursor, nullptr, 10);
+        if (field == 14) {
+            utime = value;
+        } else if (field == 15) {
+            stime = value;
+        }
+        cursor = std::strchr(cursor, ' ');
+        if (!cursor) {
+            break;
+        }
+    }
+    
+    static const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    out.cpuTimeUs = (utime + stime) * 1000000 / (ticksPerSecond > 0 ? ticksPerSecond : 100);
+    return true;
+}
+#endif
+}
+
+ResourceMonitor::ResourceMonitor()
+    : m_lastSampleNs(0)
+{
+}
+
+const ResourceSample& ResourceMonitor::sample() {
+    qint64 nowNs = steadyNowNs();
+    
+    m_next.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    sampleProcess(m_next);
+    sampleThreads(m_next);
+    
+    if (m_lastSampleNs > 0) {
+        computeCpuPercent(m_next, nowNs - m_lastSampleNs);
+    }
+    m_lastSampleNs = nowNs;
+    
+    // The previous sample's buffers are reused by the next call
+    std::swap(m_last, m_next);
+    return m_last;
+}
+
+const ResourceSample& ResourceMonitor::getLastSample() const {
+    return m_last;
+}
+
+void ResourceMonitor::sampleProcess(ResourceSample& sample) const {
+    sample.cpuPercent = 0.0;
+    
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        sample.cpuTimeUs = fileTimeUs(kernel) + fileTimeUs(user);
+    }
+    
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        sample.residentBytes = counters.WorkingSetSize;
+        sample.peakResidentBytes = counters.PeakWorkingSetSize;
+        sample.minorFaults = counters.PageFaultCount;
+    }
+    
+    // Windows has no per-process context switch counter short of NtQuery*
+    sample.voluntarySwitches = 0;
+    sample.involuntarySwitches = 0;
+    sample.majorFaults = 0;
+#else
+    // getrusage sums every thread; /proc/self/status only counts the main
+    // thread's context switches
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        sample.cpuTimeUs = static_cast<qint64>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 +
+                           usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+        sample.voluntarySwitches = static_cast<quint64>(usage.ru_nvcsw);
+        sample.involuntarySwitches = static_cast<quint64>(usage.ru_nivcsw);
+        sample.minorFaults = static_cast<quint64>(usage.ru_minflt);
+        sample.majorFaults = static_cast<quint64>(usage.ru_majflt);
+#ifdef __APPLE__
+        sample.peakResidentBytes = static_cast<quint64>(usage.ru_maxrss);
+#else
+        sample.peakResidentBytes = static_cast<quint64>(usage.ru_maxrss) * 1024;
+#endif
+    }
+    
+#ifdef __linux__
+    char status[4096];
+    if (readProcFile("/proc/self/status", status, sizeof(status))) {
+        sample.residentBytes = statusField(status, "VmRSS:") * 1024;
+        sample.peakResidentBytes = statusField(status, "VmHWM:") * 1024;
+    }
+#endif
+#endif
+}
+
+void ResourceMonitor::sampleThreads(ResourceSample& sample) const {
+    sample.threads.clear();
+    
+#ifdef _WIN32
+    static const GetThreadDescriptionFn getThreadDescription =
+        kernel32Function<GetThreadDescriptionFn>("GetThreadDescription");
+    
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    
+    DWORD processId = GetCurrentProcessId();
+    THREADENTRY32 entry;
+    entry.dwSize = sizeof(entry);
+    
+    for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+        if (entry.th32OwnerProcessID != processId) {
+            continue;
+        }
+        
+        HANDLE thread = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, entry.th32ThreadID);
+        if (!thread) {
+            continue;
+        }
+        
+        ThreadResourceSample threadSample;
+        threadSample.threadId = entry.th32ThreadID;
+        
+        FILETIME creation, exit, kernel, user;
+        if (GetThreadTimes(thread, &creation, &exit, &kernel, &user)) {
+            threadSample.cpuTimeUs = fileTimeUs(kernel) + fileTimeUs(user);
+        }
+        
+        PWSTR description = nullptr;
+        if (getThreadDescription && SUCCEEDED(getThreadDescription(thread, &description)) && description) {
+            threadSample.name = QString::fromWCharArray(description);
+            LocalFree(description);
+        }
+        
+        CloseHandle(thread);
+        sample.threads.push_back(std::move(threadSample));
+    }
+    
+    CloseHandle(snapshot);
+#elif defined(__linux__)
+    DIR* tasks = opendir("/proc/self/task");
+    if (!tasks) {
+        return;
+    }
+    
+    char path[64];
+    char buffer[4096];
+    
+    while (dirent* task = readdir(tasks)) {
+        if (task->d_name[0] < '0' || task->d_name[0] > '9') {
+            continue;
+        }
+        
+        // Threads can exit between readdir() and the reads below
+        long long threadId = std::strtoll(task->d_name, nullptr, 10);
+        std::snprintf(path, sizeof(path), "/proc/self/task/%lld/stat", threadId);
+        TaskStat stat;
+        if (!readProcFile(path, buffer, sizeof(buffer)) || !parseTaskStat(buffer, stat)) {
+            continue;
+        }
+        
+        ThreadResourceSample threadSample;
+        threadSample.threadId = threadId;
+        threadSample.name = QString::fromUtf8(stat.name, stat.nameLength);
+        threadSample.cpuTimeUs = stat.cpuTimeUs;
+        
+        std::snprintf(path, sizeof(path), "/proc/self/task/%lld/status", threadId);
+        if (readProcFile(path, buffer, sizeof(buffer))) {
+            threadSample.voluntarySwitches = statusField(buffer, "voluntary_ctxt_switches:");
+            threadSample.involuntarySwitches = statusField(buffer, "nonvoluntary_ctxt_switches:");
+        }
+        
+        sample.threads.push_back(std::move(threadSample));
+    }
+    
+    closedir(tasks);
+#endif
+    
+    std::sort(sample.threads.begin(), sample.threads.end(),
+              [](const ThreadResourceSample& a, const ThreadResourceSample& b) {
+                  return a.threadId < b.threadId;
+              });
+}
+
+void ResourceMonitor::computeCpuPercent(ResourceSample& sample, qint64 elapsedNs) const {
+    if (elapsedNs <= 0) {
+        return;
+    }
+    
+    double elapsedUs = elapsedNs / 1000.0;
+    sample.cpuPercent = std::max<qint64>(0, sample.cpuTimeUs - m_last.cpuTimeUs) * 100.0 / elapsedUs;
+    
+    // Both lists are sorted by id; threads new since the last sample show 0%
+    auto previous = m_last.threads.begin();
+    for (auto& thread : sample.threads) {
+        while (previous != m_last.threads.end() && previous->threadId < thread.threadId) {
+            ++previous;
+        }
+        if (previous != m_last.threads.end() && previous->threadId == thread.threadId) {
+            thread.cpuPercent = std::max<qint64>(0, thread.cpuTimeUs - previous->cpuTimeUs) * 100.0 / elapsedUs;
+        }
+    }
+}
+
+void ResourceMonitor::setCurrentThreadName(const char* name) {
+#ifdef _WIN32
+    static const SetThreadDescriptionFn setThreadDescription =
+        kernel32Function<SetThreadDescriptionFn>("SetThreadDescription");
+    if (setThreadDescription) {
+        setThreadDescription(GetCurrentThread(), reinterpret_cast<PCWSTR>(QString::fromUtf8(name).utf16()));
+    }
+#elif defined(__APPLE__)
+    pthread_setname_np(name);
+#else
+    char truncated[16];
+    std::snprintf(truncated, sizeof(truncated), "%s", name);
+    pthread_setname_np(pthread_self(), truncated);
+#endif
+}
@@ -1,5 +1,6 @@
 #include "core/ScreenCapture.h"
 #include <QGuiApplication>
+#include <QCursor>
 #include <QScreen>
 #include <QPixmap>
 #include <QElapsedTimer>
@@ -11,6 +12,7 @@ ScreenCapture::ScreenCapture(QObject* parent)
     : QObject(parent)
     , m_activeMonitor(0)
     , m_lastCaptureTime(0.0)
+    , m_bufferAllocations(0)
 #ifdef _WIN32
     , m_screenDC(nullptr)
     , m_memDC(nullptr)
@@ -18,6 +20,10 @@ ScreenCapture::ScreenCapture(QObject* parent)
     , m_bitmapData(nullptr)
     , m_captureWidth(0)
     , m_captureHeight(0)
+    , m_patchDC(nullptr)
+    , m_patchBitmap(nullptr)
+    , m_patchData(nullptr)
+    , m_patchSize(0)
 #endif
 {
     detectMonitors();
@@ -46,6 +52,7 @@ void ScreenCapture::detectMonitors() {
         info.geometry = screen->geometry();
         info.isPrimary = (screen == primaryScreen);
         info.dpi = screen->logicalDotsPerInch();
+        info.devicePixelRatio = screen->devicePixelRatio();
         m_monitors.push_back(info);
     }
 }
@@ -94,10 +101,50 @@ QPoint ScreenCapture::getScreenCenter() const {
     return QPoint(offset.x() + size.width() / 2, offset.y() + size.height() / 2);
 }
 
+double ScreenCapture::getCaptureScale() const {
+    return getCaptureScale(getCurrentMonitorInfo());
+}
+
+double ScreenCapture::getCaptureScale(const MonitorInfo& monitor) {
+    // Qt 6 keeps logical DPI near 96 on scaled displays; the device pixel
+    // ratio is what separates GDI's physical pixels from Qt's logical ones
+    return monitor.devicePixelRatio > 0.0 ? std::max(0.5, static_cast<double>(monitor.devicePixelRatio)) : 1.0;
+}
+
+CoordinateTransform ScreenCapture::getLastTransform() const {
+    return m_lastTransform;
+}
+
+CoordinateTransform ScreenCapture::makeTransform(const QPoint& roiOffset) const {
+    CoordinateTransform transform;
+    transform.monitorOrigin = getCurrentMonitorInfo().geometry.topLeft();
+    transform.roiOffset = roiOffset;
+    transform.scale = getCaptureScale();
+    return transform;
+}
+
 double ScreenCapture::getLastCaptureTime() const {
     return m_lastCaptureTime;
 }
 
+quint64 ScreenCapture::getBufferAllocations() const {
+    return m_bufferAllocations;
+}
+
+cv::Mat& ScreenCapture::reuseBuffer(cv::Mat& buffer, int rows, int cols) {
+    // A frame still referenced downstream (recorder, queued detection) must
+    // not be overwritten; drop our reference and let create() allocate anew.
+    // Only references can raise the count, so a count of 1 stays ours.
+    if (buffer.u && buffer.u->refcount > 1) {
+        buffer.release();
+    }
+    if (buffer.rows != rows || buffer.cols != cols || buffer.type() != CV_8UC3) {
+        buffer.create(rows, cols, CV_8UC3);
+        ++m_bufferAllocations;
+    }
+    return buffer;
+}
+
 #ifdef _WIN32
 void ScreenCapture::initWindowsCapture() {
     MonitorInfo monitor = getCurrentMonitorInfo();
@@ -120,6 +167,17 @@ void ScreenCapture::initWindowsCapture() {
 }
 
 void ScreenCapture::cleanupWindowsCapture() {
+    if (m_patchBitmap) {
+        DeleteObject(m_patchBitmap);
+        m_patchBitmap = nullptr;
+    }
+    if (m_patchDC) {
+        DeleteDC(m_patchDC);
+        m_patchDC = nullptr;
+    }
+    m_patchData = nullptr;
+    m_patchSize = 0;
+    
     if (m_bitmap) {
         DeleteObject(m_bitmap);
         m_bitmap = nullptr;
@@ -145,10 +203,11 @@ cv::Mat ScreenCapture::captureWindows() {
            m_screenDC, monitor.geometry.x(), monitor.geometry.y(), SRCCOPY);
     
     cv::Mat result(m_captureHeight, m_captureWidth, CV_8UC4, m_bitmapData);
-    cv::Mat bgr;
+    cv::Mat& bgr = reuseBuffer(m_frameBuffer, m_captureHeight, m_captureWidth);
     cv::cvtColor(result, bgr, cv::COLOR_BGRA2BGR);
     
-    m_lastCaptureTime = timer.elapsed();
+    m_lastTransform = makeTransform(QPoint(0, 0));
+    m_lastCaptureTime = timer.nsecsElapsed() / 1e6;
     return bgr;
 }
 
@@ -177,14 +236,15 @@ cv::Mat ScreenCapture::captureWindowsRegion(const QRect& region) {
     BitBlt(regionDC, 0, 0, region.width(), region.height(), m_screenDC, x, y, SRCCOPY);
     
     cv::Mat result(region.height(), region.width(), CV_8UC4, regionData);
-    cv::Mat bgr;
+    cv::Mat& bgr = reuseBuffer(m_regionBuffer, region.height(), region.width());
     cv::cvtColor(result, bgr, cv::COLOR_BGRA2BGR);
     
     DeleteObject(regionBitmap);
     DeleteDC(regionDC);
     
-    m_lastCaptureTime = timer.elapsed();
-    return bgr.clone();
+    m_lastTransform = makeTransform(region.topLeft());
+    m_lastCaptureTime = timer.nsecsElapsed() / 1e6;
+    return bgr;
 }
 #endif
 
@@ -201,11 +261,13 @@ cv::Mat ScreenCapture::capture() {
     
     cv::Mat mat(image.height(), image.width(), CV_8UC3, 
                 const_cast<uchar*>(image.bits()), image.bytesPerLine());
-    cv::Mat bgr;
+    // Converted into our own buffer, so nothing points into the QImage
+    cv::Mat& bgr = reuseBuffer(m_frameBuffer, image.height(), image.width());
     cv::cvtColor(mat, bgr, cv::COLOR_RGB2BGR);
     
-    m_lastCaptureTime = timer.elapsed();
-    return bgr.clone();
+    m_lastTransform = makeTransform(QPoint(0, 0));
+    m_lastCaptureTime = timer.nsecsElapsed() / 1e6;
+    return bgr;
 #endif
 }
 
@@ -219,8 +281,14 @@ cv::Mat ScreenCapture::captureRegion(const QRect& region) {
     int y = std::max(0, region.y());
     int width = std::min(region.width(), fullCapture.cols - x);
     int height = std::min(region.height(), fullCapture.rows - y);
+    if (width <= 0 || height <= 0) {
+        return cv::Mat();
+    }
     
-    return fullCapture(cv::Rect(x, y, width, height)).clone();
+    m_lastTransform = makeTransform(QPoint(x, y));
+    cv::Mat& roi = reuseBuffer(m_regionBuffer, height, width);
+    fullCapture(cv::Rect(x, y, width, height)).copyTo(roi);
+    return roi;
 #endif
 }
 
@@ -232,6 +300,83 @@ cv::Mat ScreenCapture::captureFOV(int centerX, int centerY, int radius) {
     return captureRegion(QRect(x, y, size, size));
 }
 
+bool ScreenCapture::capturePatchAtCursor(int radius, cv::Mat& out) {
+    int size = std::max(0, radius) * 2 + 1;
+    
+#ifdef _WIN32
+    // GDI and GetCursorPos both work in physical pixels, so no DPI mapping
+    POINT cursor;
+    if (!m_screenDC || !GetCursorPos(&cursor)) {
+        return false;
+    }
+    
+    if (m_patchSize != size) {
+        if (m_patchBitmap) {
+            DeleteObject(m_patchBitmap);
+        }
+        if (!m_patchDC) {
+            m_patchDC = CreateCompatibleDC(m_screenDC);
+        }
+        
+        BITMAPINFO bmi = {};
+        bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+        bmi.bmiHeader.biWidth = size;
+        bmi.bmiHeader.biHeight = -size;
+        bmi.bmiHeader.biPlanes = 1;
+        bmi.bmiHeader.biBitCount = 32;
+        bmi.bmiHeader.biCompression = BI_RGB;
+        
+        m_patchBitmap = CreateDIBSection(m_patchDC, &bmi, DIB_RGB_COLORS, &m_patchData, nullptr, 0);
+        if (!m_patchBitmap) {
+            m_patchData = nullptr;
+            m_patchSize = 0;
+            return false;
+        }
+        SelectObject(m_patchDC, m_patchBitmap);
+        m_patchSize = size;
+    }
+    
+    // m_screenDC covers the whole virtual desktop; off-screen parts come back black
+    if (!BitBlt(m_patchDC, 0, 0, size, size, m_screenDC, cursor.x - radius, cursor.y - radius, SRCCOPY)) {
+        return false;
+    }
+    GdiFlush();
+    
+    cv::Mat bgra(size, size, CV_8UC4, m_patchData);
+    cv::cvtColor(bgra, out, cv::COLOR_BGRA2BGR);
+    return true;
+#else
+    QPoint cursor = QCursor::pos();
+    QScreen* screen = QGuiApplication::screenAt(cursor);
+    if (!screen) {
+        screen = QGuiApplication::primaryScreen();
+    }
+    if (!screen) {
+        return false;
+    }
+    
+    // One grab of just the patch; with window 0 the offset is relative to
+    // the screen the cursor is on
+    QPoint origin = cursor - screen->geometry().topLeft() - QPoint(radius, radius);
+    QImage image = screen->grabWindow(0, origin.x(), origin.y(), size, size)
+        .toImage().convertToFormat(QImage::Format_RGB888);
+    if (image.isNull()) {
+        return false;
+    }
+    
+    cv::Mat rgb(image.height(), image.width(), CV_8UC3,
+                const_cast<uchar*>(image.constBits()), image.bytesPerLine());
+    if (rgb.cols != size || rgb.rows != size) {
+        // High-DPI screens grab in device pixels
+        cv::Mat scaled;
+        cv::resize(rgb, scaled, cv::Size(size, size), 0, 0, cv::INTER_AREA);
+        rgb = scaled;
+    }
+    cv::cvtColor(rgb, out, cv::COLOR_RGB2BGR);
+    return true;
+#endif
+}
+
 QImage ScreenCapture::convertToQImage(const cv::Mat& mat) {
     if (mat.type() == CV_8UC3) {
         cv::Mat rgb;
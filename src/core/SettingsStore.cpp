@@ -0,0 +1,79 @@
+#include "core/SettingsStore.h"
+#include <algorithm>
+
+SettingsStore::SettingsStore(const DetectionSettings& initial)
+    : m_current(nullptr)
+    , m_readerVersion(kNoReader)
+    , m_readerSnapshot(nullptr)
+    , m_nextVersion(1)
+{
+    DetectionSettings* first = new DetectionSettings(initial);
+    first->version = m_nextVersion++;
+    m_current.store(first, std::memory_order_release);
+}
+
+SettingsStore::~SettingsStore() {
+    delete m_current.load(std::memory_order_acquire);
+}
+
+DetectionSettings SettingsStore::get() const {
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    return *m_current.load(std::memory_order_acquire);
+}
+
+void SettingsStore::publish(const DetectionSettings& settings) {
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    publishLocked(settings);
+}
+
+void SettingsStore::publishLocked(const DetectionSettings& settings) {
+    DetectionSettings* next = new DetectionSettings(settings);
+    next->version = m_nextVersion++;
+    
+    const DetectionSettings* previous = m_current.exchange(next, std::memory_order_acq_rel);
+    m_retired.emplace_back(previous);
+    
+    reclaimLocked();
+}
+
+void SettingsStore::reclaimLocked() {
+    // The reader only ever holds a snapshot at or after the version it last
+    // announced, so anything older is unreachable
+    quint64 readerVersion = m_readerVersion.load(std::memory_order_seq_cst);
+    
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+                                   [readerVersion](const std::unique_ptr<const DetectionSettings>& settings) {
+                                       return settings->version < readerVersion;
+                                   }),
+                    m_retired.end());
+}
+
+const DetectionSettings& SettingsStore::acquire() {
+    // A detached reader pins everything before its first load so the
+    // snapshot it is about to load can't be reclaimed underneath it
+    if (!m_readerSnapshot) {
+        m_readerVersion.store(0, std::memory_order_seq_cst);
+    }
+    
+    const DetectionSettings* current = m_current.load(std::memory_order_seq_cst);
+    
+    if (current != m_readerSnapshot) {
+        m_readerSnapshot = current;
+        m_readerVersion.store(current->version, std::memory_order_seq_cst);
+    }
+    
+    return *m_readerSnapshot;
+}
+
+void SettingsStore::detachReader() {
+    m_readerSnapshot = nullptr;
+    m_readerVersion.store(kNoReader, std::memory_order_seq_cst);
+    
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    reclaimLocked();
+}
+
+quint64 SettingsStore::getVersion() const {
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    return m_current.load(std::memory_order_acquire)->version;
+}
@@ -0,0 +1,55 @@
+#include "core/TargetFeed.h"
+
+TargetFeed::TargetFeed(size_t reserveTargets)
+    : m_writeIndex(0)
+    , m_readIndex(1)
+    , m_middle(2)
+    , m_notifyPending(false)
+    , m_sequence(0)
+{
+    for (auto& buffer : m_buffers) {
+        buffer.targets.reserve(reserveTargets);
+    }
+}
+
+void TargetFeed::setNotifier(std::function<void()> notifier) {
+    m_notifier = std::move(notifier);
+}
+
+TargetSnapshot& TargetFeed::writeBuffer() {
+    return m_buffers[m_writeIndex];
+}
+
+void TargetFeed::publish() {
+    m_buffers[m_writeIndex].sequence = m_sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    // Hand the filled buffer over and take back whichever one was shared
+    int previous = m_middle.exchange(m_writeIndex | kFreshBit, std::memory_order_acq_rel);
+    m_writeIndex = previous & kIndexMask;
+
+    // Coalesce: only wake the consumer if it hasn't been woken already
+    if (m_notifier && !m_notifyPending.exchange(true, std::memory_order_acq_rel)) {
+        m_notifier();
+    }
+}
+
+bool TargetFeed::acquire() {
+    // Re-arm the wakeup first so a publish racing with this call isn't lost
+    m_notifyPending.store(false, std::memory_order_release);
+
+    if (!(m_middle.load(std::memory_order_acquire) & kFreshBit)) {
+        return false;
+    }
+
+    int previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+    m_readIndex = previous & kIndexMask;
+    return true;
+}
+
+const TargetSnapshot& TargetFeed::readBuffer() const {
+    return m_buffers[m_readIndex];
+}
+
+quint64 TargetFeed::getPublishedCount() const {
+    return m_sequence.load(std::memory_order_relaxed);
+}
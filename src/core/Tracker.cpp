@@ -1,24 +1,60 @@
 #include "core/Tracker.h"
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 
+namespace {
+qint64 steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
 Tracker::Tracker(QObject* parent)
     : QObject(parent)
     , m_screenCapture(std::make_unique<ScreenCapture>())
     , m_colorDetection(std::make_unique<ColorDetection>())
     , m_mouseController(std::make_unique<MouseController>())
+    , m_frameRecorder(std::make_unique<FrameRecorder>())
+    , m_governor(std::make_unique<AdaptiveGovernor>())
+    , m_targetFeed(std::make_unique<TargetFeed>())
+    , m_metrics(std::make_unique<MetricsRegistry>())
+    , m_settings(std::make_unique<SettingsStore>())
     , m_isRunning(false)
     , m_isEnabled(true)
     , m_targetFPS(144)
+    , m_feedHasTargets(false)
+    , m_roiCaptureEnabled(true)
+    , m_frameSignalsEnabled(false)
+    , m_settingsVersion(0)
     , m_currentFPS(0.0)
     , m_frameCount(0)
     , m_totalTargetsDetected(0)
     , m_totalAssists(0)
     , m_totalRunningTime(0)
+    , m_maxFrameAgeMs(0)
+    , m_staleFramesDropped(0)
+    , m_staleDetectionsDropped(0)
+    , m_intervalFrames(0)
+    , m_intervalCaptureMs(0.0)
+    , m_intervalDetectMs(0.0)
+    , m_intervalFrameCostMs(0.0)
+    , m_intervalMaxFrameCostMs(0.0)
+    , m_lastBufferAllocations(0)
 {
     m_trackerTimer = new QTimer(this);
+    m_trackerTimer->setTimerType(Qt::PreciseTimer);
     connect(m_trackerTimer, &QTimer::timeout, this, &Tracker::onTrackerTick);
     
+    // Governor decisions are applied as soon as they are made
+    m_governor->setFPSRange(30, m_targetFPS);
+    connect(m_governor.get(), &AdaptiveGovernor::fpsAdjusted, this, &Tracker::applyFrameInterval);
+    connect(m_governor.get(), &AdaptiveGovernor::qualityAdjusted, [this](DetectionQuality quality) {
+        m_colorDetection->setQuality(quality);
+    });
+    
     m_statsTimer = new QTimer(this);
     m_statsTimer->setInterval(1000); // Update stats every second
     connect(m_statsTimer, &QTimer::timeout, this, &Tracker::updateStats);
@@ -26,6 +62,7 @@ Tracker::Tracker(QObject* parent)
 
 Tracker::~Tracker() {
     stop();
+    stopRecording();
 }
 
 void Tracker::start() {
@@ -35,10 +72,13 @@ void Tracker::start() {
     
     m_isRunning = true;
     m_frameCount = 0;
+    m_captureLatency.clear();
+    m_detectLatency.clear();
+    m_frameLatency.clear();
     
-    // Calculate timer interval from target FPS
-    int interval = std::max(1, 1000 / m_targetFPS);
-    m_trackerTimer->setInterval(interval);
+    // Every session starts at full quality and the target FPS
+    m_governor->reset();
+    applyFrameInterval(m_governor->getCurrentFPS());
     
     m_frameTimer.start();
     m_runningTimer.start();
@@ -60,6 +100,12 @@ void Tracker::stop() {
     m_trackerTimer->stop();
     m_statsTimer->stop();
     
+    // Lets the store free snapshots replaced while we're stopped
+    m_settings->detachReader();
+    
+    // Don't leave the last boxes hanging on the overlay
+    publishTargets({}, QPoint(), CoordinateTransform(), steadyNowNs());
+    
     emit stopped();
 }
 
@@ -87,15 +133,95 @@ MouseController* Tracker::mouseController() const {
     return m_mouseController.get();
 }
 
+FrameRecorder* Tracker::frameRecorder() const {
+    return m_frameRecorder.get();
+}
+
+bool Tracker::startRecording(const QString& filePath) {
+    return m_frameRecorder->start(filePath, createConfigSnapshot());
+}
+
+void Tracker::stopRecording() {
+    m_frameRecorder->stop();
+}
+
+bool Tracker::isRecording() const {
+    return m_frameRecorder->isRecording();
+}
+
+AdaptiveGovernor* Tracker::adaptiveGovernor() const {
+    return m_governor.get();
+}
+
+TargetFeed* Tracker::targetFeed() const {
+    return m_targetFeed.get();
+}
+
+MetricsRegistry* Tracker::metricsRegistry() const {
+    return m_metrics.get();
+}
+
+SettingsStore* Tracker::settingsStore() const {
+    return m_settings.get();
+}
+
+void Tracker::prepareProfile(const QString& name, const DetectionSettings& settings, int monitorIndex) {
+    MonitorInfo monitor = m_screenCapture->getCurrentMonitorInfo();
+    for (const auto& candidate : m_screenCapture->getMonitors()) {
+        if (candidate.index == monitorIndex) {
+            monitor = candidate;
+            break;
+        }
+    }
+    
+    // Mirror captureFrame() and processFrame() on the profile's monitor: the
+    // FOV square around its centre, aimed where the pipeline will aim
+    double scale = ScreenCapture::getCaptureScale(monitor);
+    int radius = std::clamp(settings.fovRadius, 50, 500);
+    QSize size = monitor.geometry.size();
+    int centerX = static_cast<int>(size.width() * scale / 2);
+    int centerY = static_cast<int>(size.height() * scale / 2);
+    
+    CoordinateTransform transform;
+    transform.monitorOrigin = monitor.geometry.topLeft();
+    transform.roiOffset = QPoint(centerX - radius, centerY - radius);
+    transform.scale = scale;
+    QPoint aimPoint = transform.globalToFrame(monitor.geometry.topLeft() +
+                                              QPoint(size.width() / 2, size.height() / 2));
+    
+    DetectionSettings prepared = settings;
+    prepared.derived = ColorDetection::prepare(prepared, cv::Size(radius * 2, radius * 2), aimPoint);
+    m_profiles[name] = prepared;
+}
+
+void Tracker::removeProfile(const QString& name) {
+    m_profiles.erase(name);
+}
+
+bool Tracker::activateProfile(const QString& name) {
+    auto it = m_profiles.find(name);
+    if (it == m_profiles.end()) {
+        return false;
+    }
+    
+    m_settings->publish(it->second);
+    return true;
+}
+
 void Tracker::setTargetFPS(int fps) {
     m_targetFPS = std::clamp(fps, 30, 300);
+    m_governor->setFPSRange(30, m_targetFPS);
     
     if (m_isRunning) {
-        int interval = std::max(1, 1000 / m_targetFPS);
-        m_trackerTimer->setInterval(interval);
+        applyFrameInterval(m_governor->isEnabled() ? m_governor->getCurrentFPS() : m_targetFPS);
     }
 }
 
+void Tracker::applyFrameInterval(int fps) {
+    int interval = std::max(1, 1000 / std::max(1, fps));
+    m_trackerTimer->setInterval(interval);
+}
+
 int Tracker::getTargetFPS() const {
     return m_targetFPS;
 }
@@ -108,6 +234,50 @@ bool Tracker::isEnabled() const {
     return m_isEnabled;
 }
 
+void Tracker::setAdaptiveFPSEnabled(bool enabled) {
+    m_governor->setEnabled(enabled);
+    
+    if (m_isRunning) {
+        applyFrameInterval(enabled ? m_governor->getCurrentFPS() : m_targetFPS);
+    }
+}
+
+void Tracker::setROICaptureEnabled(bool enabled) {
+    m_roiCaptureEnabled = enabled;
+}
+
+bool Tracker::isROICaptureEnabled() const {
+    return m_roiCaptureEnabled;
+}
+
+void Tracker::setMaxFrameAge(int ageMs) {
+    m_maxFrameAgeMs = std::clamp(ageMs, 0, 1000);
+}
+
+int Tracker::getMaxFrameAge() const {
+    return m_maxFrameAgeMs;
+}
+
+int Tracker::getStaleFramesDropped() const {
+    return m_staleFramesDropped;
+}
+
+int Tracker::getStaleDetectionsDropped() const {
+    return m_staleDetectionsDropped;
+}
+
+bool Tracker::isAdaptiveFPSEnabled() const {
+    return m_governor->isEnabled();
+}
+
+void Tracker::setLatencyBudget(double budgetMs) {
+    m_governor->setLatencyBudget(budgetMs);
+}
+
+double Tracker::getLatencyBudget() const {
+    return m_governor->getLatencyBudget();
+}
+
 double Tracker::getCurrentFPS() const {
     return m_currentFPS;
 }
@@ -127,50 +297,154 @@ qint64 Tracker::getRunningTimeMs() const {
     return m_totalRunningTime;
 }
 
+PipelineStats Tracker::getPipelineStats() const {
+    return m_pipelineStats;
+}
+
+PipelineStats Tracker::getLivePipelineStats() const {
+    PipelineStats stats = m_pipelineStats;
+    fillLiveStats(stats);
+    return stats;
+}
+
+void Tracker::setFrameSignalsEnabled(bool enabled) {
+    m_frameSignalsEnabled = enabled;
+    m_colorDetection->setSignalsEnabled(enabled);
+}
+
+bool Tracker::isFrameSignalsEnabled() const {
+    return m_frameSignalsEnabled;
+}
+
+void Tracker::fillLiveStats(PipelineStats& stats) const {
+    stats.targetFPS = m_targetFPS;
+    stats.governedFPS = m_governor->isEnabled() ? m_governor->getCurrentFPS() : m_targetFPS;
+    stats.governorEnabled = m_governor->isEnabled();
+    stats.quality = m_governor->getQuality();
+    stats.latencyBudgetMs = m_governor->getLatencyBudget();
+    stats.governorAdjustments = m_governor->getAdjustmentCount();
+    stats.totalTargets = m_totalTargetsDetected;
+    stats.totalAssists = m_totalAssists;
+    stats.maxFrameAgeMs = m_maxFrameAgeMs;
+    stats.staleFramesDropped = m_staleFramesDropped;
+    stats.staleDetectionsDropped = m_staleDetectionsDropped;
+    stats.captureLatency = m_captureLatency.percentiles();
+    stats.detectLatency = m_detectLatency.percentiles();
+    stats.frameLatency = m_frameLatency.percentiles();
+}
+
 void Tracker::onTrackerTick() {
     if (!m_isEnabled) {
         return;
     }
     
+    QElapsedTimer costTimer;
+    costTimer.start();
+    
     processFrame();
     ++m_frameCount;
+    
+    double costMs = costTimer.nsecsElapsed() / 1e6;
+    m_intervalFrameCostMs += costMs;
+    m_intervalMaxFrameCostMs = std::max(m_intervalMaxFrameCostMs, costMs);
+    m_frameLatency.add(costMs);
+    m_metrics->observe(MetricsRegistry::Stage::Frame, costMs);
+    m_metrics->increment(MetricsRegistry::Counter::Frames);
+    
+    m_governor->recordFrameCost(costMs);
 }
 
 void Tracker::processFrame() {
-    // Capture screen
-    cv::Mat frame = m_screenCapture->capture();
+    // Pick up settings published since the last frame; one atomic load
+    const DetectionSettings& settings = m_settings->acquire();
+    if (settings.version != m_settingsVersion) {
+        applySettings(settings);
+    }
+    
+    // Capture screen; the frame's age is measured from when sampling began
+    qint64 captureTimestamp = steadyNowNs();
+    cv::Mat frame = captureFrame();
     
     if (frame.empty()) {
         return;
     }
     
-    // Get screen center
-    QPoint screenCenter = m_screenCapture->getScreenCenter();
+    m_intervalCaptureMs += m_screenCapture->getLastCaptureTime();
+    m_captureLatency.add(m_screenCapture->getLastCaptureTime());
+    m_metrics->observe(MetricsRegistry::Stage::Capture, m_screenCapture->getLastCaptureTime());
+    
+    quint64 allocations = m_screenCapture->getBufferAllocations();
+    m_metrics->increment(MetricsRegistry::Counter::FrameBufferAllocations, allocations - m_lastBufferAllocations);
+    m_lastBufferAllocations = allocations;
+    
+    if (m_frameRecorder->isRecording()) {
+        recordFrame(frame, captureTimestamp);
+    }
+    
+    // A capture that stalled past the deadline isn't worth detecting on
+    if (isStale(captureTimestamp)) {
+        ++m_staleFramesDropped;
+        m_metrics->increment(MetricsRegistry::Counter::StaleFramesDropped);
+        return;
+    }
+    
+    // Detection works in frame pixels; the transform maps results back out
+    CoordinateTransform transform = m_screenCapture->getLastTransform();
+    QPoint aimPoint = transform.globalToFrame(m_screenCapture->getScreenCenter());
     
     // Detect targets
-    std::vector<DetectedTarget> targets = m_colorDetection->detect(frame, screenCenter);
+    std::vector<DetectedTarget> targets = m_colorDetection->detect(frame, aimPoint);
+    
+    m_intervalDetectMs += m_colorDetection->getLastDetectionTime();
+    m_detectLatency.add(m_colorDetection->getLastDetectionTime());
+    m_metrics->observe(MetricsRegistry::Stage::Detect, m_colorDetection->getLastDetectionTime());
+    ++m_intervalFrames;
     
     if (targets.empty()) {
+        publishTargets(targets, QPoint(), transform, captureTimestamp);
         return;
     }
     
     m_totalTargetsDetected += static_cast<int>(targets.size());
+    m_metrics->increment(MetricsRegistry::Counter::TargetsDetected, targets.size());
     
     // Select best target
     DetectedTarget bestTarget = selectBestTarget(targets);
+    publishTargets(targets, bestTarget.center, transform, captureTimestamp);
     
-    emit targetFound(bestTarget.center);
+    QPoint targetPos = transform.frameToGlobal(bestTarget.center);
+    if (m_frameSignalsEnabled) {
+        emit targetFound(targetPos);
+    }
+    
+    // A correction computed from an old frame is worse than none
+    if (isStale(captureTimestamp)) {
+        ++m_staleDetectionsDropped;
+        m_metrics->increment(MetricsRegistry::Counter::StaleDetectionsDropped);
+        return;
+    }
     
     // Apply aim assist if mouse controller has strength > 0
     if (m_mouseController->getAimAssistStrength() > 0) {
-        QPoint currentPos = m_mouseController->getCurrentPosition();
-        m_mouseController->applyAimAssist(bestTarget.center);
+        // Only assistApplied needs the cursor's starting point
+        QPoint currentPos = m_frameSignalsEnabled ? m_mouseController->getCurrentPosition() : QPoint();
+        m_mouseController->applyAimAssist(targetPos);
         ++m_totalAssists;
+        m_metrics->increment(MetricsRegistry::Counter::Assists);
         
-        emit assistApplied(currentPos, bestTarget.center);
+        if (m_frameSignalsEnabled) {
+            emit assistApplied(currentPos, targetPos);
+        }
     }
 }
 
+void Tracker::applySettings(const DetectionSettings& settings) {
+    m_colorDetection->applySettings(settings);
+    m_mouseController->setAimAssistStrength(settings.aimAssistStrength);
+    m_mouseController->setResponseSpeed(settings.responseSpeed);
+    m_settingsVersion = settings.version;
+}
+
 DetectedTarget Tracker::selectBestTarget(const std::vector<DetectedTarget>& targets) {
     // Already sorted by distance, so first target is closest
     // But we also consider confidence
@@ -191,6 +465,79 @@ DetectedTarget Tracker::selectBestTarget(const std::vector<DetectedTarget>& targ
     return *best;
 }
 
+cv::Mat Tracker::captureFrame() {
+    if (!m_roiCaptureEnabled) {
+        return m_screenCapture->capture();
+    }
+    
+    // FOV square around the monitor centre, in capture pixels
+    QSize size = m_screenCapture->getScreenSize();
+    double scale = m_screenCapture->getCaptureScale();
+    int centerX = static_cast<int>(size.width() * scale / 2);
+    int centerY = static_cast<int>(size.height() * scale / 2);
+    
+    return m_screenCapture->captureFOV(centerX, centerY, m_colorDetection->getFOVRadius());
+}
+
+void Tracker::publishTargets(const std::vector<DetectedTarget>& targets, const QPoint& selected,
+                             const CoordinateTransform& transform, qint64 timestampNs) {
+    // Consecutive empty sets carry no news for the overlay
+    if (targets.empty() && !m_feedHasTargets) {
+        return;
+    }
+    
+    // Filled in place; the snapshot buffers keep their capacity between frames
+    TargetSnapshot& snapshot = m_targetFeed->writeBuffer();
+    snapshot.targets.clear();
+    for (const auto& target : targets) {
+        snapshot.targets.push_back({transform.frameToGlobal(target.center),
+                                    transform.frameToGlobal(target.boundingBox),
+                                    QColor(0, 255, 0, 200), target.center == selected});
+    }
+    snapshot.timestampNs = timestampNs;
+    m_targetFeed->publish();
+    
+    m_feedHasTargets = !targets.empty();
+}
+
+bool Tracker::isStale(qint64 captureTimestampNs) const {
+    if (m_maxFrameAgeMs <= 0) {
+        return false;
+    }
+    return (steadyNowNs() - captureTimestampNs) > static_cast<qint64>(m_maxFrameAgeMs) * 1000000;
+}
+
+void Tracker::recordFrame(const cv::Mat& frame, qint64 timestampNs) {
+    // Only the FOV square is recorded; the ROI shares the capture buffer and
+    // the writer thread packs it, so nothing is copied here
+    int radius = m_colorDetection->getFOVRadius();
+    cv::Rect fov(frame.cols / 2 - radius, frame.rows / 2 - radius, radius * 2, radius * 2);
+    fov &= cv::Rect(0, 0, frame.cols, frame.rows);
+    
+    if (fov.area() > 0) {
+        m_frameRecorder->pushFrame(frame(fov), timestampNs);
+    }
+}
+
+QByteArray Tracker::createConfigSnapshot() const {
+    // Read from the store: the components belong to the pipeline
+    DetectionSettings settings = m_settings->get();
+    
+    QJsonObject config;
+    config["targetColor"] = settings.targetColor.name();
+    config["colorTolerance"] = settings.colorTolerance;
+    config["fovRadius"] = settings.fovRadius;
+    config["minArea"] = settings.minArea;
+    config["maxArea"] = settings.maxArea;
+    config["morphologyEnabled"] = settings.morphologyEnabled;
+    config["aimAssistStrength"] = settings.aimAssistStrength;
+    config["responseSpeed"] = settings.responseSpeed;
+    config["targetFPS"] = m_targetFPS;
+    config["activeMonitor"] = m_screenCapture->getActiveMonitor();
+    
+    return QJsonDocument(config).toJson(QJsonDocument::Compact);
+}
+
 void Tracker::updateStats() {
     // Calculate FPS
     qint64 elapsed = m_frameTimer.elapsed();
@@ -198,9 +545,34 @@ void Tracker::updateStats() {
         m_currentFPS = (m_frameCount * 1000.0) / elapsed;
     }
     
+    // Stage costs averaged over the frames that reached detection
+    PipelineStats stats;
+    stats.fps = m_currentFPS;
+    if (m_intervalFrames > 0) {
+        stats.captureTimeMs = m_intervalCaptureMs / m_intervalFrames;
+        stats.detectTimeMs = m_intervalDetectMs / m_intervalFrames;
+    }
+    if (m_frameCount > 0) {
+        stats.frameCostMs = m_intervalFrameCostMs / m_frameCount;
+    }
+    stats.maxFrameCostMs = m_intervalMaxFrameCostMs;
+    fillLiveStats(stats);
+    m_pipelineStats = stats;
+    
+    m_metrics->set(MetricsRegistry::Gauge::FPS, stats.fps);
+    m_metrics->set(MetricsRegistry::Gauge::TargetFPS, stats.targetFPS);
+    m_metrics->set(MetricsRegistry::Gauge::GovernedFPS, stats.governedFPS);
+    m_metrics->set(MetricsRegistry::Gauge::DetectionQuality, static_cast<int>(stats.quality));
+    
     m_frameCount = 0;
+    m_intervalFrames = 0;
+    m_intervalCaptureMs = 0.0;
+    m_intervalDetectMs = 0.0;
+    m_intervalFrameCostMs = 0.0;
+    m_intervalMaxFrameCostMs = 0.0;
     m_frameTimer.restart();
     
     emit fpsUpdated(m_currentFPS);
     emit statsUpdated(m_currentFPS, m_totalTargetsDetected, m_totalAssists);
+    emit pipelineStatsUpdated(m_pipelineStats);
 }
@@ -1,19 +1,21 @@
 #include "ui/AdvancedColorPicker.h"
+#include "core/PixelSampler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QGuiApplication>
-#include <QScreen>
-#include <QCursor>
+#include <QPainter>
+#include <QPixmap>
 #include <QSettings>
 #include <cmath>
 
-AdvancedColorPicker::AdvancedColorPicker(QWidget* parent)
+AdvancedColorPicker::AdvancedColorPicker(QWidget* parent, ScreenCapture* capture)
     : QDialog(parent)
     , m_selectedColor(Qt::red)
     , m_isPicking(false)
     , m_updatingUI(false)
+    , m_sampler(new PixelSampler(capture, this))
 {
     setWindowTitle("Advanced Color Picker");
     setModal(true);
@@ -25,9 +27,7 @@ AdvancedColorPicker::AdvancedColorPicker(QWidget* parent)
 }
 
 AdvancedColorPicker::~AdvancedColorPicker() {
-    if (m_pickerTimer && m_pickerTimer->isActive()) {
-        m_pickerTimer->stop();
-    }
+    m_sampler->stop();
     saveHistory();
 }
 
@@ -74,9 +74,16 @@ void AdvancedColorPicker::setupUI() {
     m_allFormatsLabel->setWordWrap(true);
     mainLayout->addWidget(m_allFormatsLabel);
     
-    // Pick from screen button
+    // Pick from screen button, with the area averaged into the picked colour
+    QHBoxLayout* pickLayout = new QHBoxLayout();
     m_pickButton = new QPushButton("🎯 Pick from Screen");
-    mainLayout->addWidget(m_pickButton);
+    pickLayout->addWidget(m_pickButton, 1);
+    m_sampleSizeCombo = new QComboBox();
+    m_sampleSizeCombo->addItem("1 px", 0);
+    m_sampleSizeCombo->addItem("3×3 average", 1);
+    m_sampleSizeCombo->addItem("5×5 average", 2);
+    pickLayout->addWidget(m_sampleSizeCombo);
+    mainLayout->addLayout(pickLayout);
     
     // History
     QGroupBox* historyBox = new QGroupBox("History");
@@ -97,14 +104,10 @@ void AdvancedColorPicker::setupUI() {
     buttonLayout->addWidget(m_cancelButton);
     mainLayout->addLayout(buttonLayout);
     
-    // Timer for screen picking
-    m_pickerTimer = new QTimer(this);
-    m_pickerTimer->setInterval(50);
-    
     // Connections
     connect(m_hexEdit, &QLineEdit::editingFinished, this, &AdvancedColorPicker::onHexChanged);
     connect(m_pickButton, &QPushButton::clicked, this, &AdvancedColorPicker::onPickFromScreenClicked);
-    connect(m_pickerTimer, &QTimer::timeout, this, &AdvancedColorPicker::onPickerTimer);
+    connect(m_sampler, &PixelSampler::sampled, this, &AdvancedColorPicker::onPixelSampled);
     connect(m_historyList, &QListWidget::itemClicked, this, &AdvancedColorPicker::onHistoryItemClicked);
     connect(m_okButton, &QPushButton::clicked, this, &AdvancedColorPicker::onOkClicked);
     connect(m_cancelButton, &QPushButton::clicked, this, &AdvancedColorPicker::onCancelClicked);
@@ -401,38 +404,60 @@ void AdvancedColorPicker::onHexChanged() {
 }
 
 void AdvancedColorPicker::onPickFromScreenClicked() {
-    m_isPicking = !m_isPicking;
     if (m_isPicking) {
-        m_pickerTimer->start();
+        stopPicking();
+    } else {
+        m_isPicking = true;
         m_pickButton->setText("Click to pick... (ESC to cancel)");
         setCursor(Qt::CrossCursor);
-    } else {
-        m_pickerTimer->stop();
-        m_pickButton->setText("🎯 Pick from Screen");
-        setCursor(Qt::ArrowCursor);
+        m_sampler->start();
     }
 }
 
-void AdvancedColorPicker::onPickerTimer() {
-    QColor color = getColorAtCursor();
-    m_selectedColor = color;
-    updateAllDisplays();
+void AdvancedColorPicker::stopPicking() {
+    m_isPicking = false;
+    m_sampler->stop();
+    m_pickButton->setText("🎯 Pick from Screen");
+    setCursor(Qt::ArrowCursor);
+}
+
+void AdvancedColorPicker::onPixelSampled() {
+    // The magnifier follows every sample; the colour widgets only change
+    // when the picked colour does
+    updateMagnifier();
+    
+    QColor color = m_sampler->getAverageColor(m_sampleSizeCombo->currentData().toInt());
+    if (color.isValid() && color != m_selectedColor) {
+        m_selectedColor = color;
+        updateAllDisplays();
+    }
     
     if (QGuiApplication::mouseButtons() & Qt::LeftButton) {
-        m_isPicking = false;
-        m_pickerTimer->stop();
-        m_pickButton->setText("🎯 Pick from Screen");
-        setCursor(Qt::ArrowCursor);
+        stopPicking();
         addToHistory(m_selectedColor);
     }
 }
 
-QColor AdvancedColorPicker::getColorAtCursor() {
-    QPoint pos = QCursor::pos();
-    QScreen* screen = QGuiApplication::screenAt(pos);
-    if (!screen) screen = QGuiApplication::primaryScreen();
-    QPixmap pixmap = screen->grabWindow(0, pos.x(), pos.y(), 1, 1);
-    return pixmap.toImage().pixelColor(0, 0);
+void AdvancedColorPicker::updateMagnifier() {
+    QImage patch = m_sampler->getPatchImage();
+    if (patch.isNull()) {
+        return;
+    }
+    
+    // Nearest-neighbour keeps single pixels visible
+    QPixmap zoomed = QPixmap::fromImage(patch.scaled(m_magnifierLabel->contentsRect().size(),
+                                                     Qt::KeepAspectRatio, Qt::FastTransformation));
+    
+    // Outline the pixels that make up the picked colour
+    double cell = static_cast<double>(zoomed.width()) / patch.width();
+    int radius = m_sampleSizeCombo->currentData().toInt();
+    int first = patch.width() / 2 - radius;
+    QPainter painter(&zoomed);
+    painter.setPen(QPen(Qt::white, 1));
+    painter.drawRect(QRectF(first * cell, first * cell, (radius * 2 + 1) * cell - 1, (radius * 2 + 1) * cell - 1));
+    painter.end();
+    
+    m_magnifierLabel->setPixmap(zoomed);
 }
 
 void AdvancedColorPicker::onHistoryItemClicked(QListWidgetItem* item) {
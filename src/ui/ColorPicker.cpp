@@ -1,21 +1,17 @@
 #include "ui/ColorPicker.h"
+#include "core/PixelSampler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QGuiApplication>
-#include <QScreen>
-#include <QCursor>
 
-#ifdef _WIN32
-#include <windows.h>
-#endif
-
-ColorPicker::ColorPicker(QWidget* parent)
+ColorPicker::ColorPicker(QWidget* parent, ScreenCapture* capture)
     : QDialog(parent)
     , m_selectedColor(Qt::red)
     , m_originalColor(Qt::red)
     , m_isPicking(false)
+    , m_sampler(new PixelSampler(capture, this))
 {
     setWindowTitle("Color Picker");
     setModal(true);
@@ -26,9 +22,7 @@ ColorPicker::ColorPicker(QWidget* parent)
 }
 
 ColorPicker::~ColorPicker() {
-    if (m_pickerTimer && m_pickerTimer->isActive()) {
-        m_pickerTimer->stop();
-    }
+    m_sampler->stop();
 }
 
 void ColorPicker::setupUI() {
@@ -108,9 +102,8 @@ void ColorPicker::setupUI() {
     buttonLayout->addWidget(m_cancelButton);
     mainLayout->addLayout(buttonLayout);
     
-    // Timer for screen picking
-    m_pickerTimer = new QTimer(this);
-    m_pickerTimer->setInterval(50);
+    // Screen picking only needs the pixel under the cursor
+    m_sampler->setPatchRadius(0);
     
     // Connections
     connect(m_redSlider, &QSlider::valueChanged, this, &ColorPicker::onRGBChanged);
@@ -129,7 +122,7 @@ void ColorPicker::setupUI() {
     
     connect(m_hexEdit, &QLineEdit::editingFinished, this, &ColorPicker::onHexChanged);
     connect(m_pickButton, &QPushButton::clicked, this, &ColorPicker::onPickFromScreenClicked);
-    connect(m_pickerTimer, &QTimer::timeout, this, &ColorPicker::onPickerTimer);
+    connect(m_sampler, &PixelSampler::sampled, this, &ColorPicker::onPixelSampled);
     connect(m_okButton, &QPushButton::clicked, this, &ColorPicker::onOkClicked);
     connect(m_cancelButton, &QPushButton::clicked, this, &ColorPicker::onCancelClicked);
 }
@@ -202,49 +195,39 @@ void ColorPicker::onHexChanged() {
 
 void ColorPicker::onPickFromScreenClicked() {
     if (m_isPicking) {
-        m_isPicking = false;
-        m_pickerTimer->stop();
-        m_pickButton->setText("🎯 Pick from Screen");
-        setCursor(Qt::ArrowCursor);
+        stopPicking();
     } else {
         m_isPicking = true;
-        m_pickerTimer->start();
         m_pickButton->setText("Click anywhere... (ESC to cancel)");
         setCursor(Qt::CrossCursor);
+        m_sampler->start();
     }
 }
 
-void ColorPicker::onPickerTimer() {
-    QColor color = getColorAtCursor();
-    m_selectedColor = color;
-    updateSliders();
-    updateEdits();
-    updatePreview();
+void ColorPicker::stopPicking() {
+    m_isPicking = false;
+    m_sampler->stop();
+    m_pickButton->setText("🎯 Pick from Screen");
+    setCursor(Qt::ArrowCursor);
+}
+
+void ColorPicker::onPixelSampled() {
+    // Samples arrive at display rate; only a new colour touches the widgets
+    QColor color = m_sampler->getCenterColor();
+    if (color.isValid() && color != m_selectedColor) {
+        m_selectedColor = color;
+        updateSliders();
+        updateEdits();
+        updatePreview();
+    }
     
     // Check for mouse click
     if (QGuiApplication::mouseButtons() & Qt::LeftButton) {
-        m_isPicking = false;
-        m_pickerTimer->stop();
-        m_pickButton->setText("🎯 Pick from Screen");
-        setCursor(Qt::ArrowCursor);
+        stopPicking();
         emit colorSelected(m_selectedColor);
     }
 }
 
-QColor ColorPicker::getColorAtCursor() {
-    QPoint pos = QCursor::pos();
-    QScreen* screen = QGuiApplication::screenAt(pos);
-    
-    if (!screen) {
-        screen = QGuiApplication::primaryScreen();
-    }
-    
-    QPixmap pixmap = screen->grabWindow(0, pos.x(), pos.y(), 1, 1);
-    QImage image = pixmap.toImage();
-    
-    return image.pixelColor(0, 0);
-}
-
 void ColorPicker::onOkClicked() {
     emit colorSelected(m_selectedColor);
     accept();
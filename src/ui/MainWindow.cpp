@@ -1,9 +1,24 @@
 #include "ui/MainWindow.h"
 #include "ui/ColorPicker.h"
 #include "ui/AdvancedColorPicker.h"
+#include "core/PixelSampler.h"
 #include <QApplication>
 #include <QMessageBox>
 #include <QCloseEvent>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QInputDialog>
+#include <QShortcut>
+#include <QScopedValueRollback>
+
+namespace {
+// Calibration samples the square of this radius under the cursor as
+// target and everything outside kCalibrationBackgroundRadius as background
+constexpr int kCalibrationPatchRadius = 24;
+constexpr int kCalibrationTargetRadius = 4;
+constexpr int kCalibrationBackgroundRadius = 16;
+constexpr int kCalibrationSeconds = 3;
+}
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
@@ -12,10 +27,17 @@ MainWindow::MainWindow(QWidget* parent)
     , m_configManager(std::make_unique<ConfigManager>())
     , m_translationManager(std::make_unique<TranslationManager>())
     , m_statsTracker(std::make_unique<StatsTracker>())
+    , m_metricsServer(std::make_unique<MetricsServer>(m_tracker->metricsRegistry()))
+    , m_retranslator(std::make_unique<Retranslator>(m_translationManager.get()))
+    , m_statsModel(std::make_unique<StatsModel>(m_tracker.get()))
+    , m_calibrationSampler(new PixelSampler(m_tracker->screenCapture(), this))
+    , m_calibrationTimer(new QTimer(this))
+    , m_calibrationFailed(false)
     , m_isRunning(false)
+    , m_applyingConfig(false)
     , m_selectedColor(Qt::red)
 {
-    setWindowTitle("Accessibility Gaming Assistant");
+    m_retranslator->addWindowTitle(this, TrKey::AppTitle);
     setMinimumSize(500, 600);
     resize(550, 700);
     
@@ -26,11 +48,13 @@ MainWindow::MainWindow(QWidget* parent)
     setupHotkeys();
     
     loadSettings();
+    setupAutoSave();
     updateUILanguage();
 }
 
 MainWindow::~MainWindow() {
     saveSettings();
+    m_configManager->flush();
 }
 
 void MainWindow::applyDarkTheme() {
@@ -164,8 +188,11 @@ void MainWindow::setupUI() {
     mainLayout->setSpacing(15);
     mainLayout->setContentsMargins(20, 20, 20, 20);
     
+    // Translatable texts are registered with m_retranslator as widgets are
+    // created and filled in by updateUILanguage()
+    
     // Title
-    QLabel* titleLabel = new QLabel("🎮 Accessibility Gaming Assistant");
+    QLabel* titleLabel = createLabel(TrKey::AppTitle, "🎮 %1");
     titleLabel->setStyleSheet("font-size: 18px; font-weight: bold; color: #007acc;");
     titleLabel->setAlignment(Qt::AlignCenter);
     mainLayout->addWidget(titleLabel);
@@ -189,30 +216,45 @@ void MainWindow::setupMainTab() {
     layout->setSpacing(15);
     
     // Control group
-    QGroupBox* controlGroup = createGroupBox("⚡ Control");
+    QGroupBox* controlGroup = createGroupBox(TrKey::ControlGroup, "⚡ %1");
     QVBoxLayout* controlLayout = new QVBoxLayout(controlGroup);
     
-    m_startStopButton = new QPushButton("▶️ Start");
+    m_startStopButton = new QPushButton();
     m_startStopButton->setMinimumHeight(50);
     m_startStopButton->setStyleSheet("font-size: 16px;");
     controlLayout->addWidget(m_startStopButton);
     
-    m_statusLabel = new QLabel("Status: Stopped");
+    m_statusLabel = new QLabel();
     m_statusLabel->setAlignment(Qt::AlignCenter);
     controlLayout->addWidget(m_statusLabel);
     
-    m_fpsLabel = new QLabel("FPS: 0");
+    m_fpsLabel = new QLabel();
     m_fpsLabel->setAlignment(Qt::AlignCenter);
     m_fpsLabel->setStyleSheet("font-size: 14px; color: #00ff00;");
     controlLayout->addWidget(m_fpsLabel);
     
+    m_governorLabel = new QLabel();
+    m_governorLabel->setAlignment(Qt::AlignCenter);
+    m_retranslator->addCallback([this]() {
+        updateGovernorLabel();
+    });
+    controlLayout->addWidget(m_governorLabel);
+    
+    // Last two minutes of per-second FPS, with the target as a guide
+    m_fpsSparkline = new SparklineWidget();
+    m_fpsSparkline->setCapacity(120);
+    m_retranslator->addCallback([this]() {
+        updateSparklineToolTip();
+    });
+    controlLayout->addWidget(m_fpsSparkline);
+    
     layout->addWidget(controlGroup);
     
     // Quick settings
-    QGroupBox* quickGroup = createGroupBox("⚙️ Quick Settings");
+    QGroupBox* quickGroup = createGroupBox(TrKey::QuickSettings, "⚙️ %1");
     QGridLayout* quickLayout = new QGridLayout(quickGroup);
     
-    quickLayout->addWidget(new QLabel("Aim Assist:"), 0, 0);
+    quickLayout->addWidget(createLabel(TrKey::AimAssist), 0, 0);
     m_aimAssistSlider = new QSlider(Qt::Horizontal);
     m_aimAssistSlider->setRange(0, 100);
     m_aimAssistSlider->setValue(30);
@@ -221,7 +263,7 @@ void MainWindow::setupMainTab() {
     m_aimAssistLabel->setMinimumWidth(50);
     quickLayout->addWidget(m_aimAssistLabel, 0, 2);
     
-    quickLayout->addWidget(new QLabel("Response:"), 1, 0);
+    quickLayout->addWidget(createLabel(TrKey::ResponseSpeed), 1, 0);
     m_responseSpeedSlider = new QSlider(Qt::Horizontal);
     m_responseSpeedSlider->setRange(0, 100);
     m_responseSpeedSlider->setValue(50);
@@ -233,7 +275,7 @@ void MainWindow::setupMainTab() {
     layout->addWidget(quickGroup);
     layout->addStretch();
     
-    m_tabWidget->addTab(tab, "🏠 Main");
+    m_retranslator->addTab(m_tabWidget, m_tabWidget->addTab(tab, QString()), TrKey::TabMain, "🏠 %1");
 }
 
 void MainWindow::setupDetectionTab() {
@@ -242,12 +284,13 @@ void MainWindow::setupDetectionTab() {
     layout->setSpacing(15);
     
     // Color settings
-    QGroupBox* colorGroup = createGroupBox("🎨 Color Detection");
+    QGroupBox* colorGroup = createGroupBox(TrKey::ColorDetection, "🎨 %1");
     QVBoxLayout* colorLayout = new QVBoxLayout(colorGroup);
     
     QHBoxLayout* colorSelectLayout = new QHBoxLayout();
-    colorSelectLayout->addWidget(new QLabel("Target Color:"));
-    m_colorPickerButton = new QPushButton("Select Color");
+    colorSelectLayout->addWidget(createLabel(TrKey::TargetColor));
+    m_colorPickerButton = new QPushButton();
+    m_retranslator->addText(m_colorPickerButton, TrKey::SelectColor);
     m_colorPickerButton->setMinimumWidth(120);
     colorSelectLayout->addWidget(m_colorPickerButton);
     m_selectedColorLabel = new QLabel();
@@ -258,7 +301,7 @@ void MainWindow::setupDetectionTab() {
     colorLayout->addLayout(colorSelectLayout);
     
     QHBoxLayout* toleranceLayout = new QHBoxLayout();
-    toleranceLayout->addWidget(new QLabel("Tolerance:"));
+    toleranceLayout->addWidget(createLabel(TrKey::Tolerance));
     m_toleranceSlider = new QSlider(Qt::Horizontal);
     m_toleranceSlider->setRange(0, 100);
     m_toleranceSlider->setValue(30);
@@ -268,14 +311,39 @@ void MainWindow::setupDetectionTab() {
     toleranceLayout->addWidget(m_toleranceLabel);
     colorLayout->addLayout(toleranceLayout);
     
+    QHBoxLayout* calibrationLayout = new QHBoxLayout();
+    m_calibrateButton = new QPushButton();
+    m_retranslator->addText(m_calibrateButton, TrKey::Calibrate, "🧪 %1");
+    calibrationLayout->addWidget(m_calibrateButton);
+    m_clearCalibrationButton = new QPushButton();
+    m_retranslator->addText(m_clearCalibrationButton, TrKey::Clear);
+    m_clearCalibrationButton->setEnabled(false);
+    calibrationLayout->addWidget(m_clearCalibrationButton);
+    calibrationLayout->addStretch();
+    colorLayout->addLayout(calibrationLayout);
+    
+    m_calibrationLabel = new QLabel();
+    m_calibrationLabel->setStyleSheet("color: #888888;");
+    m_calibrationLabel->setWordWrap(true);
+    m_retranslator->addCallback([this]() {
+        updateCalibrationLabel();
+    });
+    colorLayout->addWidget(m_calibrationLabel);
+    
+    // Only meaningful once calibration has learned a model
+    m_backProjectionCheckbox = new QCheckBox();
+    m_retranslator->addText(m_backProjectionCheckbox, TrKey::BackProjection);
+    m_backProjectionCheckbox->setEnabled(false);
+    colorLayout->addWidget(m_backProjectionCheckbox);
+    
     layout->addWidget(colorGroup);
     
     // FOV settings
-    QGroupBox* fovGroup = createGroupBox("🎯 FOV Settings");
+    QGroupBox* fovGroup = createGroupBox(TrKey::FOVSettings, "🎯 %1");
     QVBoxLayout* fovLayout = new QVBoxLayout(fovGroup);
     
     QHBoxLayout* fovSizeLayout = new QHBoxLayout();
-    fovSizeLayout->addWidget(new QLabel("FOV Radius:"));
+    fovSizeLayout->addWidget(createLabel(TrKey::FOVRadius));
     m_fovSlider = new QSlider(Qt::Horizontal);
     m_fovSlider->setRange(50, 500);
     m_fovSlider->setValue(150);
@@ -286,9 +354,47 @@ void MainWindow::setupDetectionTab() {
     fovLayout->addLayout(fovSizeLayout);
     
     layout->addWidget(fovGroup);
+    
+    // Performance settings
+    QGroupBox* perfGroup = createGroupBox(TrKey::Performance, "⚡ %1");
+    QVBoxLayout* perfLayout = new QVBoxLayout(perfGroup);
+    
+    m_adaptiveFPSCheckbox = new QCheckBox();
+    m_retranslator->addText(m_adaptiveFPSCheckbox, TrKey::AdaptiveFPS);
+    m_adaptiveFPSCheckbox->setChecked(true);
+    perfLayout->addWidget(m_adaptiveFPSCheckbox);
+    
+    QHBoxLayout* budgetLayout = new QHBoxLayout();
+    budgetLayout->addWidget(createLabel(TrKey::LatencyBudget));
+    m_latencyBudgetSlider = new QSlider(Qt::Horizontal);
+    m_latencyBudgetSlider->setRange(1, 30);
+    m_latencyBudgetSlider->setValue(6);
+    budgetLayout->addWidget(m_latencyBudgetSlider);
+    m_latencyBudgetLabel = new QLabel("6ms");
+    m_latencyBudgetLabel->setMinimumWidth(50);
+    budgetLayout->addWidget(m_latencyBudgetLabel);
+    perfLayout->addLayout(budgetLayout);
+    
+    QHBoxLayout* frameAgeLayout = new QHBoxLayout();
+    frameAgeLayout->addWidget(createLabel(TrKey::MaxFrameAge));
+    m_maxFrameAgeSlider = new QSlider(Qt::Horizontal);
+    // 0 turns the deadline off, which is the default: a slow full-screen
+    // grab would otherwise have every frame dropped
+    m_maxFrameAgeSlider->setRange(0, 100);
+    m_maxFrameAgeSlider->setValue(0);
+    frameAgeLayout->addWidget(m_maxFrameAgeSlider);
+    m_maxFrameAgeLabel = new QLabel();
+    m_maxFrameAgeLabel->setMinimumWidth(50);
+    m_retranslator->addCallback([this]() {
+        updateMaxFrameAgeLabel();
+    });
+    frameAgeLayout->addWidget(m_maxFrameAgeLabel);
+    perfLayout->addLayout(frameAgeLayout);
+    
+    layout->addWidget(perfGroup);
     layout->addStretch();
     
-    m_tabWidget->addTab(tab, "🔍 Detection");
+    m_retranslator->addTab(m_tabWidget, m_tabWidget->addTab(tab, QString()), TrKey::TabDetection, "🔍 %1");
 }
 
 void MainWindow::setupVisualTab() {
@@ -297,48 +403,62 @@ void MainWindow::setupVisualTab() {
     layout->setSpacing(15);
     
     // Overlay settings
-    QGroupBox* overlayGroup = createGroupBox("🖼️ Overlay");
+    QGroupBox* overlayGroup = createGroupBox(TrKey::Overlay, "🖼️ %1");
     QVBoxLayout* overlayLayout = new QVBoxLayout(overlayGroup);
     
-    m_overlayCheckbox = new QCheckBox("Enable Overlay");
+    m_overlayCheckbox = new QCheckBox();
+    m_retranslator->addText(m_overlayCheckbox, TrKey::EnableOverlay);
     m_overlayCheckbox->setChecked(true);
     overlayLayout->addWidget(m_overlayCheckbox);
     
-    m_fovCircleCheckbox = new QCheckBox("Show FOV Circle");
+    m_fovCircleCheckbox = new QCheckBox();
+    m_retranslator->addText(m_fovCircleCheckbox, TrKey::ShowFOVCircle);
     m_fovCircleCheckbox->setChecked(true);
     overlayLayout->addWidget(m_fovCircleCheckbox);
     
-    m_crosshairCheckbox = new QCheckBox("Show Crosshair");
+    m_crosshairCheckbox = new QCheckBox();
+    m_retranslator->addText(m_crosshairCheckbox, TrKey::ShowCrosshair);
     m_crosshairCheckbox->setChecked(false);
     overlayLayout->addWidget(m_crosshairCheckbox);
     
+    m_hudCheckbox = new QCheckBox();
+    m_retranslator->addText(m_hudCheckbox, TrKey::ShowHUD);
+    m_hudCheckbox->setChecked(false);
+    overlayLayout->addWidget(m_hudCheckbox);
+    
     layout->addWidget(overlayGroup);
     
     // Monitor selection
-    QGroupBox* monitorGroup = createGroupBox("🖥️ Monitor");
+    QGroupBox* monitorGroup = createGroupBox(TrKey::Monitor, "🖥️ %1");
     QVBoxLayout* monitorLayout = new QVBoxLayout(monitorGroup);
     
     QHBoxLayout* monitorSelectLayout = new QHBoxLayout();
-    monitorSelectLayout->addWidget(new QLabel("Active Monitor:"));
+    monitorSelectLayout->addWidget(createLabel(TrKey::ActiveMonitor));
     m_monitorCombo = new QComboBox();
     
     auto monitors = m_tracker->screenCapture()->getMonitors();
     for (const auto& monitor : monitors) {
-        QString text = QString("%1 (%2x%3)%4")
-            .arg(monitor.name)
-            .arg(monitor.geometry.width())
-            .arg(monitor.geometry.height())
-            .arg(monitor.isPrimary ? " [Primary]" : "");
-        m_monitorCombo->addItem(text, monitor.index);
+        m_monitorCombo->addItem(QString(), monitor.index);
     }
     
+    // Item texts carry the translated "Primary" tag
+    m_retranslator->addCallback([this]() {
+        auto monitors = m_tracker->screenCapture()->getMonitors();
+        for (const auto& monitor : monitors) {
+            int item = m_monitorCombo->findData(monitor.index);
+            if (item >= 0) {
+                m_monitorCombo->setItemText(item, monitorText(monitor));
+            }
+        }
+    });
+    
     monitorSelectLayout->addWidget(m_monitorCombo);
     monitorLayout->addLayout(monitorSelectLayout);
     
     layout->addWidget(monitorGroup);
     layout->addStretch();
     
-    m_tabWidget->addTab(tab, "👁️ Visual");
+    m_retranslator->addTab(m_tabWidget, m_tabWidget->addTab(tab, QString()), TrKey::TabVisual, "👁️ %1");
 }
 
 void MainWindow::setupSettingsTab() {
@@ -346,12 +466,40 @@ void MainWindow::setupSettingsTab() {
     QVBoxLayout* layout = new QVBoxLayout(tab);
     layout->setSpacing(15);
     
+    // Per-game profiles
+    QGroupBox* profileGroup = createGroupBox(TrKey::Profiles, "🎮 %1");
+    QVBoxLayout* profileLayout = new QVBoxLayout(profileGroup);
+    
+    QHBoxLayout* profileSelectLayout = new QHBoxLayout();
+    profileSelectLayout->addWidget(createLabel(TrKey::Profile));
+    m_profileCombo = new QComboBox();
+    m_profileCombo->setMinimumWidth(160);
+    profileSelectLayout->addWidget(m_profileCombo);
+    m_saveProfileButton = new QPushButton();
+    m_retranslator->addText(m_saveProfileButton, TrKey::SaveProfileAs, "💾 %1");
+    profileSelectLayout->addWidget(m_saveProfileButton);
+    m_deleteProfileButton = new QPushButton();
+    m_retranslator->addText(m_deleteProfileButton, TrKey::Delete, "🗑️ %1");
+    profileSelectLayout->addWidget(m_deleteProfileButton);
+    profileSelectLayout->addStretch();
+    profileLayout->addLayout(profileSelectLayout);
+    
+    QLabel* profileHint = new QLabel();
+    m_retranslator->addCallback([this, profileHint]() {
+        profileHint->setText(translate(TrKey::ProfileHint).arg(m_configManager->getProfileHotkey()));
+    });
+    profileHint->setStyleSheet("color: #888888;");
+    profileHint->setWordWrap(true);
+    profileLayout->addWidget(profileHint);
+    
+    layout->addWidget(profileGroup);
+    
     // Language settings
-    QGroupBox* langGroup = createGroupBox("🌍 Language");
+    QGroupBox* langGroup = createGroupBox(TrKey::Language, "🌍 %1");
     QVBoxLayout* langLayout = new QVBoxLayout(langGroup);
     
     QHBoxLayout* langSelectLayout = new QHBoxLayout();
-    langSelectLayout->addWidget(new QLabel("Language:"));
+    langSelectLayout->addWidget(createLabel(TrKey::Language));
     m_languageCombo = new QComboBox();
     m_languageCombo->addItem("English", "en");
     m_languageCombo->addItem("العربية", "ar");
@@ -361,15 +509,43 @@ void MainWindow::setupSettingsTab() {
     
     layout->addWidget(langGroup);
     
+    // Recording settings
+    QGroupBox* recordGroup = createGroupBox(TrKey::Recording, "🎞️ %1");
+    QVBoxLayout* recordLayout = new QVBoxLayout(recordGroup);
+    
+    m_recordCheckbox = new QCheckBox();
+    m_retranslator->addText(m_recordCheckbox, TrKey::RecordFrames);
+    m_recordCheckbox->setChecked(false);
+    recordLayout->addWidget(m_recordCheckbox);
+    
+    layout->addWidget(recordGroup);
+    
+    // Metrics endpoint
+    QGroupBox* metricsGroup = createGroupBox(TrKey::Metrics, "📈 %1");
+    QVBoxLayout* metricsLayout = new QVBoxLayout(metricsGroup);
+    
+    m_metricsCheckbox = new QCheckBox();
+    m_retranslator->addCallback([this]() {
+        m_metricsCheckbox->setText(translate(TrKey::ServeMetrics)
+            .arg(QString("http://127.0.0.1:%1/metrics").arg(m_configManager->getMetricsPort())));
+    });
+    m_metricsCheckbox->setChecked(false);
+    metricsLayout->addWidget(m_metricsCheckbox);
+    
+    layout->addWidget(metricsGroup);
+    
     // About
-    QGroupBox* aboutGroup = createGroupBox("ℹ️ About");
+    QGroupBox* aboutGroup = createGroupBox(TrKey::About, "ℹ️ %1");
     QVBoxLayout* aboutLayout = new QVBoxLayout(aboutGroup);
     
-    QLabel* versionLabel = new QLabel("Version 1.0.0");
+    QLabel* versionLabel = createLabel(TrKey::AppVersion, "%1");
     versionLabel->setAlignment(Qt::AlignCenter);
     aboutLayout->addWidget(versionLabel);
     
-    QLabel* descLabel = new QLabel("Accessibility Gaming Assistant\nHelping gamers with disabilities play better.");
+    QLabel* descLabel = new QLabel();
+    m_retranslator->addCallback([this, descLabel]() {
+        descLabel->setText(translate(TrKey::AppTitle) + "\n" + translate(TrKey::AboutDesc));
+    });
     descLabel->setAlignment(Qt::AlignCenter);
     descLabel->setWordWrap(true);
     aboutLayout->addWidget(descLabel);
@@ -377,40 +553,52 @@ void MainWindow::setupSettingsTab() {
     layout->addWidget(aboutGroup);
     layout->addStretch();
     
-    m_tabWidget->addTab(tab, "⚙️ Settings");
+    m_retranslator->addTab(m_tabWidget, m_tabWidget->addTab(tab, QString()), TrKey::TabSettings, "⚙️ %1");
 }
 
 void MainWindow::setupStatsDisplay() {
-    QGroupBox* statsGroup = createGroupBox("📊 Statistics");
+    QGroupBox* statsGroup = createGroupBox(TrKey::Statistics, "📊 %1");
     QHBoxLayout* statsLayout = new QHBoxLayout(statsGroup);
     
-    m_targetsLabel = new QLabel("Targets: 0");
+    m_targetsLabel = new QLabel();
     statsLayout->addWidget(m_targetsLabel);
     
-    m_assistsLabel = new QLabel("Assists: 0");
+    m_assistsLabel = new QLabel();
     statsLayout->addWidget(m_assistsLabel);
     
-    m_runTimeLabel = new QLabel("Time: 00:00:00");
+    m_runTimeLabel = new QLabel();
     statsLayout->addWidget(m_runTimeLabel);
     
+    // Run state and stats text mix translations with live values
+    m_retranslator->addCallback([this]() {
+        m_startStopButton->setText(m_isRunning ? "⏹️ " + translate(TrKey::ButtonStop)
+                                               : "▶️ " + translate(TrKey::ButtonStart));
+        m_statusLabel->setText(translate(m_isRunning ? TrKey::StatusRunning : TrKey::StatusStopped));
+        onStatsModelUpdated(m_statsModel->getSnapshot(), StatsModel::AllFields);
+    });
+    
     qobject_cast<QVBoxLayout*>(m_centralWidget->layout())->addWidget(statsGroup);
 }
 
 void MainWindow::setupTrayIcon() {
     m_trayIcon = new QSystemTrayIcon(this);
-    m_trayIcon->setToolTip("Accessibility Gaming Assistant");
     
     m_trayMenu = new QMenu(this);
     
-    QAction* showAction = m_trayMenu->addAction("Show/Hide");
+    QAction* showAction = m_trayMenu->addAction(QString());
+    m_retranslator->addAction(showAction, TrKey::ShowHide);
     connect(showAction, &QAction::triggered, this, &MainWindow::onShowHideAction);
     
     m_trayMenu->addSeparator();
     
-    QAction* quitAction = m_trayMenu->addAction("Quit");
+    QAction* quitAction = m_trayMenu->addAction(QString());
+    m_retranslator->addAction(quitAction, TrKey::Quit);
     connect(quitAction, &QAction::triggered, this, &MainWindow::onQuitAction);
     
     m_trayIcon->setContextMenu(m_trayMenu);
+    m_retranslator->addCallback([this]() {
+        m_trayIcon->setToolTip(translate(TrKey::AppTitle));
+    });
     
     connect(m_trayIcon, &QSystemTrayIcon::activated, this, &MainWindow::onTrayActivated);
     
@@ -427,15 +615,53 @@ void MainWindow::setupConnections() {
     connect(m_fovSlider, &QSlider::valueChanged, this, &MainWindow::onFOVChanged);
     connect(m_toleranceSlider, &QSlider::valueChanged, this, &MainWindow::onToleranceChanged);
     
+    // Performance
+    connect(m_adaptiveFPSCheckbox, &QCheckBox::toggled, [this](bool checked) {
+        m_tracker->setAdaptiveFPSEnabled(checked);
+        m_latencyBudgetSlider->setEnabled(checked);
+    });
+    connect(m_latencyBudgetSlider, &QSlider::valueChanged, [this](int value) {
+        m_latencyBudgetLabel->setText(QString("%1ms").arg(value));
+        m_tracker->setLatencyBudget(value);
+    });
+    connect(m_maxFrameAgeSlider, &QSlider::valueChanged, [this](int value) {
+        updateMaxFrameAgeLabel();
+        m_tracker->setMaxFrameAge(value);
+    });
+    
     // Color picker
     connect(m_colorPickerButton, &QPushButton::clicked, [this]() {
-        AdvancedColorPicker picker(this);
+        // Screen picking samples through the tracker's capture backend
+        AdvancedColorPicker picker(this, m_tracker->screenCapture());
         picker.setColor(m_selectedColor);
         if (picker.exec() == QDialog::Accepted) {
+            // A hand-picked colour goes back to colour ± tolerance
             onColorSelected(picker.getSelectedColor());
+            applyCalibration(CalibratedColorRange(), nullptr);
+            saveSettings();
         }
     });
     
+    // Colour calibration
+    m_calibrationSampler->setPatchRadius(kCalibrationPatchRadius);
+    m_calibrationTimer->setSingleShot(true);
+    m_calibrationTimer->setInterval(kCalibrationSeconds * 1000);
+    connect(m_calibrateButton, &QPushButton::clicked, this, &MainWindow::onCalibrateClicked);
+    connect(m_calibrationSampler, &PixelSampler::sampled, this, &MainWindow::onCalibrationSampled);
+    connect(m_calibrationTimer, &QTimer::timeout, this, &MainWindow::finishCalibration);
+    connect(m_clearCalibrationButton, &QPushButton::clicked, [this]() {
+        m_calibrationFailed = false;
+        applyCalibration(CalibratedColorRange(), nullptr);
+        saveSettings();
+    });
+    connect(m_backProjectionCheckbox, &QCheckBox::toggled, [this](bool checked) {
+        ColorMatchMode mode = checked ? ColorMatchMode::BackProjection : ColorMatchMode::Range;
+        m_tracker->settingsStore()->update([mode](DetectionSettings& settings) {
+            settings.colorMatchMode = mode;
+        });
+        updateCalibrationLabel();
+    });
+    
     // Checkboxes
     connect(m_overlayCheckbox, &QCheckBox::toggled, [this](bool checked) {
         m_overlay->setOverlayEnabled(checked);
@@ -449,6 +675,53 @@ void MainWindow::setupConnections() {
         m_overlay->setCrosshairVisible(checked);
     });
     
+    connect(m_hudCheckbox, &QCheckBox::toggled, [this](bool checked) {
+        m_overlay->setHUDVisible(checked);
+    });
+    
+    connect(m_metricsCheckbox, &QCheckBox::toggled, [this](bool checked) {
+        if (!checked) {
+            m_metricsServer->stop();
+            return;
+        }
+        if (!m_metricsServer->start(static_cast<quint16>(m_configManager->getMetricsPort()))) {
+            updateStatus(translate(TrKey::MetricsUnavailable)
+                .arg(m_metricsServer->getErrorString()));
+            m_metricsCheckbox->setChecked(false);
+        }
+    });
+    
+    // Profiles
+    connect(m_profileCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), [this](int index) {
+        if (index >= 0) {
+            switchProfile(m_profileCombo->itemText(index));
+        }
+    });
+    
+    connect(m_saveProfileButton, &QPushButton::clicked, [this]() {
+        bool ok = false;
+        QString name = QInputDialog::getText(this, translate(TrKey::SaveProfile), translate(TrKey::ProfileName), QLineEdit::Normal,
+                                             m_profileCombo->currentText(), &ok).trimmed();
+        if (!ok || name.isEmpty()) {
+            return;
+        }
+        saveSettings();
+        m_configManager->saveProfile(name);
+        m_configManager->scheduleSave();
+        refreshProfiles();
+    });
+    
+    connect(m_deleteProfileButton, &QPushButton::clicked, [this]() {
+        QString name = m_profileCombo->currentText();
+        if (name.isEmpty()) {
+            return;
+        }
+        m_configManager->deleteProfile(name);
+        m_configManager->scheduleSave();
+        m_tracker->removeProfile(name);
+        refreshProfiles();
+    });
+    
     // Combos
     connect(m_monitorCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), 
             this, &MainWindow::onMonitorChanged);
@@ -456,28 +729,128 @@ void MainWindow::setupConnections() {
             this, &MainWindow::onLanguageChanged);
     
     // Tracker signals
-    connect(m_tracker.get(), &Tracker::statsUpdated, this, &MainWindow::onStatsUpdated);
+    // Labels follow 4 Hz coalesced snapshots rather than tracker signals
+    connect(m_statsModel.get(), &StatsModel::updated, this, &MainWindow::onStatsModelUpdated);
+    connect(m_tracker.get(), &Tracker::pipelineStatsUpdated, this, &MainWindow::onPipelineStatsUpdated);
+    connect(m_tracker.get(), &Tracker::pipelineStatsUpdated,
+            m_statsTracker.get(), &StatsTracker::recordPipelineStats);
+    connect(m_statsTracker.get(), &StatsTracker::rollupRecorded, this, &MainWindow::onRollupRecorded);
+    connect(m_configManager.get(), &ConfigManager::configReloaded, this, &MainWindow::onConfigReloaded);
+    // Writes happen on a background thread; this is the only place a failed one surfaces
+    connect(m_configManager.get(), &ConfigManager::saveFailed, [this](const QString& error) {
+        updateStatus(translate(TrKey::SaveFailed).arg(error));
+    });
+    
+    // Detections reach the overlay through the lock-free feed, not a signal
+    m_overlay->setTargetFeed(m_tracker->targetFeed());
+    m_overlay->setHUDStatsProvider([this]() {
+        return m_tracker->getLivePipelineStats();
+    });
+    m_retranslator->addCallback([this]() {
+        m_overlay->setHUDFormats({translate(TrKey::HudFPS), translate(TrKey::HudCapture),
+                                  translate(TrKey::HudDetect), translate(TrKey::HudFrame),
+                                  translate(TrKey::HudDropped), translate(TrKey::HudTargets)});
+    });
+    
+    MonitorInfo monitor = m_tracker->screenCapture()->getCurrentMonitorInfo();
+    m_overlay->setCaptureMonitor(monitor.geometry);
 }
 
 void MainWindow::setupHotkeys() {
     // Platform-specific hotkey setup would go here
     // For simplicity, we're not implementing global hotkeys in this version
+    
+    // Profile cycling works while any of our windows has focus
+    QShortcut* profileShortcut = new QShortcut(QKeySequence(m_configManager->getProfileHotkey()), this);
+    profileShortcut->setContext(Qt::ApplicationShortcut);
+    connect(profileShortcut, &QShortcut::activated, this, &MainWindow::cycleProfile);
+}
+
+void MainWindow::refreshProfiles() {
+    QStringList names = m_configManager->getProfileNames();
+    
+    // Every profile is prepared up front so switching never builds anything
+    for (const QString& name : names) {
+        QJsonObject profile = m_configManager->getProfile(name);
+        m_tracker->prepareProfile(name, settingsForProfile(profile),
+                                  profile.value("activeMonitor").toInt(m_configManager->getActiveMonitor()));
+    }
+    
+    QSignalBlocker blocker(m_profileCombo);
+    m_profileCombo->clear();
+    m_profileCombo->addItems(names);
+    m_profileCombo->setCurrentIndex(names.indexOf(m_configManager->getActiveProfile()));
+    m_deleteProfileButton->setEnabled(!names.isEmpty());
+}
+
+void MainWindow::switchProfile(const QString& name) {
+    // The pipeline swaps to the prepared snapshot first; the widgets then
+    // follow through configReloaded and republish identical values. Every
+    // differing key is applied before anything is saved (autosave is held
+    // off while onConfigReloaded runs), so the widgets, the config and the
+    // live snapshot end up agreeing.
+    if (!m_tracker->activateProfile(name)) {
+        return;
+    }
+    m_configManager->applyProfile(name);
+    m_configManager->scheduleSave();
+    
+    updateStatus(translate(TrKey::StatusProfile).arg(name));
+}
+
+void MainWindow::cycleProfile() {
+    int count = m_profileCombo->count();
+    if (count == 0) {
+        return;
+    }
+    m_profileCombo->setCurrentIndex((m_profileCombo->currentIndex() + 1) % count);
+}
+
+DetectionSettings MainWindow::settingsForProfile(const QJsonObject& profile) const {
+    // Settings a profile doesn't mention keep their live values
+    DetectionSettings settings = m_tracker->settingsStore()->get();
+    settings.derived.reset();
+    
+    settings.aimAssistStrength = profile.value("aimAssistStrength").toInt(settings.aimAssistStrength);
+    settings.responseSpeed = profile.value("responseSpeed").toInt(settings.responseSpeed);
+    settings.fovRadius = profile.value("fovRadius").toInt(settings.fovRadius);
+    settings.colorTolerance = profile.value("colorTolerance").toInt(settings.colorTolerance);
+    if (profile.contains("targetColor")) {
+        settings.targetColor = QColor(profile.value("targetColor").toString());
+    }
+    if (profile.contains("calibratedRange")) {
+        settings.calibratedRange = ConfigManager::parseCalibratedRange(profile.value("calibratedRange"));
+    }
+    if (profile.contains("hueSatModel")) {
+        settings.hueSatModel = ConfigManager::parseHueSatModel(profile.value("hueSatModel"));
+    }
+    if (profile.contains("backProjection")) {
+        settings.colorMatchMode = profile.value("backProjection").toBool()
+            ? ColorMatchMode::BackProjection : ColorMatchMode::Range;
+    }
+    
+    return settings;
 }
 
 void MainWindow::onStartStopClicked() {
     if (m_isRunning) {
         m_tracker->stop();
+        m_tracker->stopRecording();
         m_statsTracker->endSession();
         m_isRunning = false;
-        m_startStopButton->setText("▶️ Start");
-        m_statusLabel->setText("Status: Stopped");
+        m_startStopButton->setText("▶️ " + translate(TrKey::ButtonStart));
+        m_statusLabel->setText(translate(TrKey::StatusStopped));
         m_statusLabel->setStyleSheet("color: #ff6666;");
     } else {
+        if (m_recordCheckbox->isChecked()) {
+            m_tracker->startRecording(createRecordingPath());
+        }
+        
         m_tracker->start();
         m_statsTracker->startSession();
         m_isRunning = true;
-        m_startStopButton->setText("⏹️ Stop");
-        m_statusLabel->setText("Status: Running");
+        m_startStopButton->setText("⏹️ " + translate(TrKey::ButtonStop));
+        m_statusLabel->setText(translate(TrKey::StatusRunning));
         m_statusLabel->setStyleSheet("color: #66ff66;");
         
         if (m_overlayCheckbox->isChecked()) {
@@ -494,17 +867,23 @@ void MainWindow::onToggleOverlay() {
 
 void MainWindow::onAimAssistChanged(int value) {
     m_aimAssistLabel->setText(QString("%1%").arg(value));
-    m_tracker->mouseController()->setAimAssistStrength(value);
+    m_tracker->settingsStore()->update([value](DetectionSettings& settings) {
+        settings.aimAssistStrength = value;
+    });
 }
 
 void MainWindow::onResponseSpeedChanged(int value) {
     m_responseSpeedLabel->setText(QString("%1%").arg(value));
-    m_tracker->mouseController()->setResponseSpeed(value);
+    m_tracker->settingsStore()->update([value](DetectionSettings& settings) {
+        settings.responseSpeed = value;
+    });
 }
 
 void MainWindow::onFOVChanged(int value) {
     m_fovLabel->setText(QString("%1px").arg(value));
-    m_tracker->colorDetection()->setFOVRadius(value);
+    m_tracker->settingsStore()->update([value](DetectionSettings& settings) {
+        settings.fovRadius = value;
+    });
     m_overlay->setFOVRadius(value);
 }
 
@@ -513,45 +892,288 @@ void MainWindow::onColorSelected(const QColor& color) {
     m_selectedColorLabel->setStyleSheet(
         QString("background-color: %1; border: 2px solid #3e3e42; border-radius: 4px;")
             .arg(color.name()));
-    m_tracker->colorDetection()->setTargetColor(color);
+    m_tracker->settingsStore()->update([color](DetectionSettings& settings) {
+        settings.targetColor = color;
+    });
 }
 
 void MainWindow::onToleranceChanged(int value) {
     m_toleranceLabel->setText(QString::number(value));
-    m_tracker->colorDetection()->setColorTolerance(value);
+    m_tracker->settingsStore()->update([value](DetectionSettings& settings) {
+        settings.colorTolerance = value;
+    });
+}
+
+void MainWindow::onCalibrateClicked() {
+    if (m_calibrationSampler->isRunning()) {
+        return;
+    }
+    
+    if (m_calibrationBackgroundMask.empty()) {
+        int size = kCalibrationPatchRadius * 2 + 1;
+        m_calibrationBackgroundMask = cv::Mat(size, size, CV_8U, cv::Scalar(255));
+        cv::circle(m_calibrationBackgroundMask, cv::Point(kCalibrationPatchRadius, kCalibrationPatchRadius),
+                   kCalibrationBackgroundRadius, cv::Scalar(0), cv::FILLED);
+    }
+    
+    m_colorCalibrator.reset();
+    m_calibrateButton->setEnabled(false);
+    m_calibrationSampler->start();
+    m_calibrationTimer->start();
+    updateCalibrationLabel();
+}
+
+void MainWindow::onCalibrationSampled() {
+    const cv::Mat& patch = m_calibrationSampler->getPatch();
+    if (patch.size() != m_calibrationBackgroundMask.size()) {
+        return;
+    }
+    
+    int targetSize = kCalibrationTargetRadius * 2 + 1;
+    int offset = kCalibrationPatchRadius - kCalibrationTargetRadius;
+    m_colorCalibrator.addTarget(patch(cv::Rect(offset, offset, targetSize, targetSize)));
+    m_colorCalibrator.addBackground(patch, m_calibrationBackgroundMask);
+}
+
+void MainWindow::finishCalibration() {
+    m_calibrationSampler->stop();
+    m_calibrateButton->setEnabled(true);
+    
+    m_lastCalibration = m_colorCalibrator.compute();
+    m_calibrationFailed = !m_lastCalibration.range.valid;
+    if (m_lastCalibration.range.valid) {
+        onColorSelected(m_lastCalibration.meanColor);
+        applyCalibration(m_lastCalibration.range, m_lastCalibration.hueSatModel);
+        saveSettings();
+    } else {
+        updateCalibrationLabel();
+    }
+}
+
+void MainWindow::updateMaxFrameAgeLabel() {
+    int value = m_maxFrameAgeSlider->value();
+    m_maxFrameAgeLabel->setText(value > 0 ? QString("%1ms").arg(value) : translate(TrKey::Off));
+}
+
+void MainWindow::applyCalibration(const CalibratedColorRange& range, const std::shared_ptr<const HueSatModel>& model) {
+    m_calibratedRange = range;
+    m_hueSatModel = model;
+    m_tracker->settingsStore()->update([range, model](DetectionSettings& settings) {
+        settings.calibratedRange = range;
+        settings.hueSatModel = model;
+    });
+    
+    // Tolerance has no effect while the calibrated range is in use
+    m_toleranceSlider->setEnabled(!range.valid);
+    m_clearCalibrationButton->setEnabled(range.valid || model);
+    m_backProjectionCheckbox->setEnabled(model != nullptr);
+    updateCalibrationLabel();
+}
+
+void MainWindow::updateCalibrationLabel() {
+    if (m_calibrationSampler->isRunning()) {
+        m_calibrationLabel->setText(translate(TrKey::Calibrating).arg(kCalibrationSeconds));
+        m_calibrationLabel->setToolTip(QString());
+    } else if (m_calibratedRange.valid) {
+        m_calibrationLabel->setText(QString("%1: H %2-%3, S %4-%5, V %6-%7")
+                                        .arg(translate(TrKey::Calibrated))
+                                        .arg(m_calibratedRange.lower[0]).arg(m_calibratedRange.upper[0])
+                                        .arg(m_calibratedRange.lower[1]).arg(m_calibratedRange.upper[1])
+                                        .arg(m_calibratedRange.lower[2]).arg(m_calibratedRange.upper[2]));
+        // Only known for a range calibrated in this session
+        bool current = m_lastCalibration.range == m_calibratedRange;
+        bool backProjection = m_backProjectionCheckbox->isChecked() && m_hueSatModel;
+        m_calibrationLabel->setToolTip(current
+            ? translate(TrKey::CalibrationStats)
+                  .arg(translate(backProjection ? TrKey::BackProjectionShort : TrKey::HSVRange))
+                  .arg((backProjection ? m_lastCalibration.modelCoverage : m_lastCalibration.targetCoverage) * 100.0,
+                       0, 'f', 1)
+                  .arg((backProjection ? m_lastCalibration.modelBackgroundRate : m_lastCalibration.backgroundRate) * 100.0,
+                       0, 'f', 2)
+            : QString());
+    } else if (m_calibrationFailed) {
+        m_calibrationLabel->setText(translate(TrKey::CalibrationFailed));
+        m_calibrationLabel->setToolTip(QString());
+    } else {
+        m_calibrationLabel->clear();
+        m_calibrationLabel->setToolTip(QString());
+    }
 }
 
 void MainWindow::onMonitorChanged(int index) {
     int monitorIndex = m_monitorCombo->itemData(index).toInt();
     m_tracker->screenCapture()->setActiveMonitor(monitorIndex);
+    
+    MonitorInfo monitor = m_tracker->screenCapture()->getCurrentMonitorInfo();
+    m_overlay->setCaptureMonitor(monitor.geometry);
 }
 
 void MainWindow::onLanguageChanged(int index) {
     QString langCode = m_languageCombo->itemData(index).toString();
     m_translationManager->setLanguage(langCode);
+    
+    // Texts and the RTL flip go out in one batch
     updateUILanguage();
+}
+
+void MainWindow::onConfigReloaded(const QStringList& changedKeys) {
+    // Only the widgets whose keys changed are touched; their handlers push
+    // the values into the live settings snapshot as if the user had moved
+    // them, so capture keeps running and unaffected caches stay warm.
+    // Autosave stays off meanwhile: it writes every widget back, and the
+    // widgets for keys not applied yet still hold their old values.
+    QScopedValueRollback<bool> applying(m_applyingConfig, true);
+    for (const QString& key : changedKeys) {
+        if (key == "aimAssistStrength") {
+            m_aimAssistSlider->setValue(m_configManager->getAimAssistStrength());
+        } else if (key == "responseSpeed") {
+            m_responseSpeedSlider->setValue(m_configManager->getResponseSpeed());
+        } else if (key == "fovRadius") {
+            m_fovSlider->setValue(m_configManager->getFOVRadius());
+        } else if (key == "colorTolerance") {
+            m_toleranceSlider->setValue(m_configManager->getColorTolerance());
+        } else if (key == "targetColor") {
+            onColorSelected(m_configManager->getTargetColor());
+        } else if (key == "calibratedRange") {
+            applyCalibration(m_configManager->getCalibratedRange(), m_hueSatModel);
+        } else if (key == "hueSatModel") {
+            applyCalibration(m_calibratedRange, m_configManager->getHueSatModel());
+        } else if (key == "backProjection") {
+            m_backProjectionCheckbox->setChecked(m_configManager->isBackProjectionEnabled());
+        } else if (key == "adaptiveFPS") {
+            m_adaptiveFPSCheckbox->setChecked(m_configManager->isAdaptiveFPSEnabled());
+        } else if (key == "latencyBudgetMs") {
+            m_latencyBudgetSlider->setValue(static_cast<int>(m_configManager->getLatencyBudget()));
+        } else if (key == "maxFrameAgeMs") {
+            m_maxFrameAgeSlider->setValue(m_configManager->getMaxFrameAge());
+        } else if (key == "overlayEnabled") {
+            m_overlayCheckbox->setChecked(m_configManager->isOverlayEnabled());
+        } else if (key == "fovCircleVisible") {
+            m_fovCircleCheckbox->setChecked(m_configManager->isFOVCircleVisible());
+        } else if (key == "crosshairVisible") {
+            m_crosshairCheckbox->setChecked(m_configManager->isCrosshairVisible());
+        } else if (key == "hudVisible") {
+            m_hudCheckbox->setChecked(m_configManager->isHUDVisible());
+        } else if (key == "overlayLayerCaching") {
+            m_overlay->setLayerCachingEnabled(m_configManager->isOverlayLayerCachingEnabled());
+        } else if (key == "recordFrames") {
+            m_recordCheckbox->setChecked(m_configManager->isRecordingEnabled());
+        } else if (key == "metricsEndpoint") {
+            m_metricsCheckbox->setChecked(m_configManager->isMetricsEndpointEnabled());
+        } else if (key == "language") {
+            int langIndex = m_languageCombo->findData(m_configManager->getLanguage());
+            if (langIndex >= 0) {
+                m_languageCombo->setCurrentIndex(langIndex);
+            }
+        } else if (key == "activeMonitor") {
+            int monitorIndex = m_monitorCombo->findData(m_configManager->getActiveMonitor());
+            if (monitorIndex >= 0) {
+                m_monitorCombo->setCurrentIndex(monitorIndex);
+            }
+        } else if (key == "profiles") {
+            refreshProfiles();
+        }
+    }
+}
+
+void MainWindow::onStatsModelUpdated(const StatsSnapshot& stats, int changedFields) {
+    // Only labels whose value moved are reformatted
+    if (changedFields & StatsModel::FPS) {
+        m_fpsLabel->setText(QString("%1: %2").arg(translate(TrKey::FPS)).arg(stats.fps));
+    }
+    if (changedFields & StatsModel::Targets) {
+        m_targetsLabel->setText(QString("%1: %2").arg(translate(TrKey::Targets)).arg(stats.targets));
+    }
+    if (changedFields & StatsModel::Assists) {
+        m_assistsLabel->setText(QString("%1: %2").arg(translate(TrKey::Assists)).arg(stats.assists));
+    }
     
-    // Handle RTL for Arabic
-    if (m_translationManager->isRTL()) {
-        setLayoutDirection(Qt::RightToLeft);
+    if (changedFields & StatsModel::RunTime) {
+        qint64 runTime = stats.runTimeSeconds;
+        int hours = runTime / 3600;
+        int minutes = (runTime % 3600) / 60;
+        int seconds = runTime % 60;
+        m_runTimeLabel->setText(QString("%1: %2:%3:%4")
+            .arg(translate(TrKey::Time))
+            .arg(hours, 2, 10, QChar('0'))
+            .arg(minutes, 2, 10, QChar('0'))
+            .arg(seconds, 2, 10, QChar('0')));
+    }
+}
+
+void MainWindow::onPipelineStatsUpdated(const PipelineStats& stats) {
+    m_lastPipelineStats = stats;
+    updateGovernorLabel();
+}
+
+void MainWindow::updateGovernorLabel() {
+    static const TrKey qualityNames[] = {TrKey::QualityFull, TrKey::QualityNoMorphology,
+                                         TrKey::QualityHalf, TrKey::QualityQuarter};
+    
+    const PipelineStats& stats = m_lastPipelineStats;
+    QString quality = translate(qualityNames[static_cast<int>(stats.quality)]);
+    QString text;
+    if (stats.governorEnabled) {
+        text = translate(TrKey::GovernorStatus)
+            .arg(quality)
+            .arg(stats.governedFPS)
+            .arg(stats.targetFPS)
+            .arg(stats.frameCostMs, 0, 'f', 1);
     } else {
-        setLayoutDirection(Qt::LeftToRight);
+        text = translate(TrKey::QualityStatus)
+            .arg(quality)
+            .arg(stats.frameCostMs, 0, 'f', 1);
     }
+    
+    text += '\n' + translate(TrKey::StaleDropped)
+        .arg(stats.staleFramesDropped)
+        .arg(stats.staleDetectionsDropped);
+    m_governorLabel->setText(text);
 }
 
-void MainWindow::onStatsUpdated(double fps, int targets, int assists) {
-    m_fpsLabel->setText(QString("FPS: %1").arg(static_cast<int>(fps)));
-    m_targetsLabel->setText(QString("Targets: %1").arg(targets));
-    m_assistsLabel->setText(QString("Assists: %1").arg(assists));
+void MainWindow::onRollupRecorded(const MetricsRollup& rollup) {
+    Q_UNUSED(rollup);
+    
+    std::vector<MetricsRollup> history = m_statsTracker->getRecentRollups(m_fpsSparkline->getCapacity());
     
-    qint64 runTime = m_tracker->getRunningTimeMs();
-    int hours = runTime / 3600000;
-    int minutes = (runTime % 3600000) / 60000;
-    int seconds = (runTime % 60000) / 1000;
-    m_runTimeLabel->setText(QString("Time: %1:%2:%3")
-        .arg(hours, 2, 10, QChar('0'))
-        .arg(minutes, 2, 10, QChar('0'))
-        .arg(seconds, 2, 10, QChar('0')));
+    std::vector<double> fps;
+    fps.reserve(history.size());
+    for (const auto& entry : history) {
+        fps.push_back(entry.fps);
+    }
+    
+    m_fpsSparkline->setReferenceValue(m_tracker->getTargetFPS());
+    m_fpsSparkline->setValues(fps);
+    updateSparklineToolTip();
+    
+    // Process resources are sampled with the rollup; mirror them to /metrics
+    const ResourceSample& resources = m_statsTracker->getLastResourceSample();
+    MetricsRegistry* metrics = m_tracker->metricsRegistry();
+    metrics->set(MetricsRegistry::Gauge::ResidentMemoryBytes, static_cast<double>(resources.residentBytes));
+    metrics->set(MetricsRegistry::Gauge::PeakResidentMemoryBytes, static_cast<double>(resources.peakResidentBytes));
+    metrics->set(MetricsRegistry::Gauge::ProcessCPUPercent, resources.cpuPercent);
+    // Per rollup window, so toggling layer caching shows up in the next one
+    metrics->set(MetricsRegistry::Gauge::OverlayPaintMs, m_overlay->getAveragePaintTime());
+    m_overlay->resetPaintStats();
+    metrics->setTotal(MetricsRegistry::Counter::VoluntaryContextSwitches, resources.voluntarySwitches);
+    metrics->setTotal(MetricsRegistry::Counter::InvoluntaryContextSwitches, resources.involuntarySwitches);
+    metrics->setTotal(MetricsRegistry::Counter::PageFaults, resources.minorFaults + resources.majorFaults);
+}
+
+void MainWindow::updateSparklineToolTip() {
+    QString toolTip = translate(TrKey::FPSHistory);
+    std::vector<MetricsRollup> latest = m_statsTracker->getRecentRollups(1);
+    if (!latest.empty()) {
+        const MetricsRollup& rollup = latest.back();
+        toolTip += '\n' + translate(TrKey::RollupDetails)
+            .arg(rollup.frameP95Ms, 0, 'f', 2)
+            .arg(rollup.cpuTimeMs, 0, 'f', 0)
+            .arg(rollup.residentKb / 1024.0, 0, 'f', 1)
+            .arg(rollup.voluntarySwitches)
+            .arg(rollup.involuntarySwitches)
+            .arg(rollup.pageFaults);
+    }
+    m_fpsSparkline->setToolTip(toolTip);
 }
 
 void MainWindow::onTrayActivated(QSystemTrayIcon::ActivationReason reason) {
@@ -571,6 +1193,9 @@ void MainWindow::onShowHideAction() {
 
 void MainWindow::onQuitAction() {
     saveSettings();
+    if (!m_configManager->flush()) {
+        QMessageBox::warning(this, translate(TrKey::AppTitle), translate(TrKey::SettingsNotSaved));
+    }
     qApp->quit();
 }
 
@@ -604,19 +1229,35 @@ void MainWindow::loadSettings() {
     m_responseSpeedSlider->setValue(m_configManager->getResponseSpeed());
     m_fovSlider->setValue(m_configManager->getFOVRadius());
     m_toleranceSlider->setValue(m_configManager->getColorTolerance());
+    m_adaptiveFPSCheckbox->setChecked(m_configManager->isAdaptiveFPSEnabled());
+    m_latencyBudgetSlider->setValue(static_cast<int>(m_configManager->getLatencyBudget()));
+    m_maxFrameAgeSlider->setValue(m_configManager->getMaxFrameAge());
     
     QColor color = m_configManager->getTargetColor();
     onColorSelected(color);
+    applyCalibration(m_configManager->getCalibratedRange(), m_configManager->getHueSatModel());
+    m_backProjectionCheckbox->setChecked(m_configManager->isBackProjectionEnabled());
     
     m_overlayCheckbox->setChecked(m_configManager->isOverlayEnabled());
     m_fovCircleCheckbox->setChecked(m_configManager->isFOVCircleVisible());
     m_crosshairCheckbox->setChecked(m_configManager->isCrosshairVisible());
+    m_hudCheckbox->setChecked(m_configManager->isHUDVisible());
+    m_overlay->setLayerCachingEnabled(m_configManager->isOverlayLayerCachingEnabled());
+    m_recordCheckbox->setChecked(m_configManager->isRecordingEnabled());
+    m_metricsCheckbox->setChecked(m_configManager->isMetricsEndpointEnabled());
     
     QString lang = m_configManager->getLanguage();
     int langIndex = m_languageCombo->findData(lang);
     if (langIndex >= 0) {
         m_languageCombo->setCurrentIndex(langIndex);
     }
+    
+    int monitorIndex = m_monitorCombo->findData(m_configManager->getActiveMonitor());
+    if (monitorIndex >= 0) {
+        m_monitorCombo->setCurrentIndex(monitorIndex);
+    }
+    
+    refreshProfiles();
 }
 
 void MainWindow::saveSettings() {
@@ -624,29 +1265,95 @@ void MainWindow::saveSettings() {
     m_configManager->setResponseSpeed(m_responseSpeedSlider->value());
     m_configManager->setFOVRadius(m_fovSlider->value());
     m_configManager->setColorTolerance(m_toleranceSlider->value());
+    m_configManager->setAdaptiveFPSEnabled(m_adaptiveFPSCheckbox->isChecked());
+    m_configManager->setLatencyBudget(m_latencyBudgetSlider->value());
+    m_configManager->setMaxFrameAge(m_maxFrameAgeSlider->value());
     m_configManager->setTargetColor(m_selectedColor);
+    m_configManager->setCalibratedRange(m_calibratedRange);
+    m_configManager->setHueSatModel(m_hueSatModel);
+    m_configManager->setBackProjectionEnabled(m_backProjectionCheckbox->isChecked());
     
     m_configManager->setOverlayEnabled(m_overlayCheckbox->isChecked());
     m_configManager->setFOVCircleVisible(m_fovCircleCheckbox->isChecked());
     m_configManager->setCrosshairVisible(m_crosshairCheckbox->isChecked());
+    m_configManager->setHUDVisible(m_hudCheckbox->isChecked());
+    m_configManager->setRecordingEnabled(m_recordCheckbox->isChecked());
+    m_configManager->setMetricsEndpointEnabled(m_metricsCheckbox->isChecked());
     
     m_configManager->setLanguage(m_languageCombo->currentData().toString());
+    m_configManager->setActiveMonitor(m_monitorCombo->currentData().toInt());
+    
+    // Debounced and written off the GUI thread; only changed values count
+    m_configManager->scheduleSave();
+}
+
+void MainWindow::setupAutoSave() {
+    // Connected after loadSettings() so restoring the widgets one by one
+    // doesn't write half-loaded state back
+    // Changes made while a reload or profile switch is applied are already
+    // in the config
+    auto persist = [this]() {
+        if (!m_applyingConfig) {
+            saveSettings();
+        }
+    };
+    
+    for (QSlider* slider : {m_aimAssistSlider, m_responseSpeedSlider, m_fovSlider, m_toleranceSlider,
+                            m_latencyBudgetSlider, m_maxFrameAgeSlider}) {
+        connect(slider, &QSlider::valueChanged, this, persist);
+    }
+    
+    for (QCheckBox* checkbox : {m_adaptiveFPSCheckbox, m_backProjectionCheckbox, m_overlayCheckbox,
+                                m_fovCircleCheckbox, m_crosshairCheckbox, m_hudCheckbox, m_recordCheckbox,
+                                m_metricsCheckbox}) {
+        connect(checkbox, &QCheckBox::toggled, this, persist);
+    }
     
-    m_configManager->save();
+    connect(m_languageCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, persist);
+    connect(m_monitorCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, persist);
 }
 
 void MainWindow::updateUILanguage() {
-    // Update all translatable UI text
-    setWindowTitle(m_translationManager->tr("app_title"));
-    // Additional translations would be applied here
+    // One batched pass over every registered text with a single relayout;
+    // its cost is published so a switch can be checked against a frame
+    qint64 elapsedUs = m_retranslator->apply(this);
+    m_tracker->metricsRegistry()->set(MetricsRegistry::Gauge::UIRetranslateMs, elapsedUs / 1000.0);
 }
 
 void MainWindow::updateStatus(const QString& status) {
     m_statusLabel->setText(status);
 }
 
-QGroupBox* MainWindow::createGroupBox(const QString& title) {
-    QGroupBox* box = new QGroupBox(title);
+QString MainWindow::createRecordingPath() const {
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss");
+    return QString("%1/recordings/session_%2.agarec").arg(appDataPath, timestamp);
+}
+
+QGroupBox* MainWindow::createGroupBox(TrKey title, const QString& format) {
+    QGroupBox* box = new QGroupBox();
     box->setStyleSheet("QGroupBox { font-size: 13px; }");
+    m_retranslator->addTitle(box, title, format);
     return box;
 }
+
+QLabel* MainWindow::createLabel(TrKey key, const QString& format) {
+    QLabel* label = new QLabel();
+    m_retranslator->addText(label, key, format);
+    return label;
+}
+
+QString MainWindow::translate(TrKey key) const {
+    return m_translationManager->tr(key);
+}
+
+QString MainWindow::monitorText(const MonitorInfo& monitor) const {
+    QString text = QString("%1 (%2x%3)")
+        .arg(monitor.name)
+        .arg(monitor.geometry.width())
+        .arg(monitor.geometry.height());
+    if (monitor.isPrimary) {
+        text += QString(" [%1]").arg(translate(TrKey::Primary));
+    }
+    return text;
+}
@@ -0,0 +1,109 @@
+#include "ui/Retranslator.h"
+#include <QAbstractButton>
+#include <QAction>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QGroupBox>
+#include <QLabel>
+#include <QTabWidget>
+#include <QWidget>
+
+Retranslator::Retranslator(const TranslationManager* translations)
+    : m_translations(translations)
+    , m_lastApplyUs(0)
+{
+}
+
+void Retranslator::add(Kind kind, void* target, int index, TrKey key, const QString& format) {
+    m_entries.push_back({kind, target, index, key, format});
+}
+
+void Retranslator::addText(QLabel* label, TrKey key, const QString& format) {
+    add(Kind::Label, label, 0, key, format);
+}
+
+void Retranslator::addText(QAbstractButton* button, TrKey key, const QString& format) {
+    add(Kind::Button, button, 0, key, format);
+}
+
+void Retranslator::addTitle(QGroupBox* group, TrKey key, const QString& format) {
+    add(Kind::GroupTitle, group, 0, key, format);
+}
+
+void Retranslator::addTab(QTabWidget* tabs, int index, TrKey key, const QString& format) {
+    add(Kind::Tab, tabs, index, key, format);
+}
+
+void Retranslator::addAction(QAction* action, TrKey key, const QString& format) {
+    add(Kind::Action, action, 0, key, format);
+}
+
+void Retranslator::addWindowTitle(QWidget* window, TrKey key, const QString& format) {
+    add(Kind::WindowTitle, window, 0, key, format);
+}
+
+void Retranslator::addCallback(std::function<void()> callback) {
+    m_callbacks.push_back(std::move(callback));
+}
+
+qint64 Retranslator::apply(QWidget* root) {
+    QElapsedTimer timer;
+    timer.start();
+    
+    // Every setText below would otherwise schedule its own repaint and
+    // layout pass; with updates off they only invalidate geometry
+    root->setUpdatesEnabled(false);
+    
+    for (const Entry& entry : m_entries) {
+        QString text = entry.format.arg(m_translations->tr(entry.key));
+        
+        switch (entry.kind) {
+        case Kind::Label:
+            static_cast<QLabel*>(entry.target)->setText(text);
+            break;
+        case Kind::Button:
+            static_cast<QAbstractButton*>(entry.target)->setText(text);
+            break;
+        case Kind::GroupTitle:
+            static_cast<QGroupBox*>(entry.target)->setTitle(text);
+            break;
+        case Kind::Tab:
+            static_cast<QTabWidget*>(entry.target)->setTabText(entry.index, text);
+            break;
+        case Kind::Action:
+            static_cast<QAction*>(entry.target)->setText(text);
+            break;
+        case Kind::WindowTitle:
+            static_cast<QWidget*>(entry.target)->setWindowTitle(text);
+            break;
+        }
+    }
+    
+    for (const auto& callback : m_callbacks) {
+        callback();
+    }
+    
+    // Mirroring propagates to every child; doing it here folds its relayout
+    // into the same pass as the text changes
+    Qt::LayoutDirection direction = m_translations->isRTL() ? Qt::RightToLeft : Qt::LeftToRight;
+    if (root->layoutDirection() != direction) {
+        root->setLayoutDirection(direction);
+    }
+    
+    // Layout requests are compressed per widget, so this runs each layout
+    // once; doing it now keeps the cost inside the measurement
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+    
+    root->setUpdatesEnabled(true);
+    
+    m_lastApplyUs = timer.nsecsElapsed() / 1000;
+    return m_lastApplyUs;
+}
+
+qint64 Retranslator::getLastApplyUs() const {
+    return m_lastApplyUs;
+}
+
+int Retranslator::count() const {
+    return static_cast<int>(m_entries.size() + m_callbacks.size());
+}
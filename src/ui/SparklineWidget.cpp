@@ -0,0 +1,105 @@
+#include "ui/SparklineWidget.h"
+#include <QPainter>
+#include <algorithm>
+
+SparklineWidget::SparklineWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_capacity(120)
+    , m_referenceValue(0.0)
+    , m_lineColor(QColor(0, 255, 0))
+    , m_scaleMax(1.0)
+{
+    setMinimumHeight(40);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+}
+
+SparklineWidget::~SparklineWidget() {
+}
+
+void SparklineWidget::setValues(const std::vector<double>& values) {
+    m_values = values;
+    rebuildPolyline();
+    update();
+}
+
+void SparklineWidget::setCapacity(int points) {
+    m_capacity = std::max(2, points);
+    rebuildPolyline();
+    update();
+}
+
+int SparklineWidget::getCapacity() const {
+    return m_capacity;
+}
+
+void SparklineWidget::setReferenceValue(double value) {
+    m_referenceValue = value;
+    rebuildPolyline();
+    update();
+}
+
+void SparklineWidget::setLineColor(const QColor& color) {
+    m_lineColor = color;
+    update();
+}
+
+QSize SparklineWidget::sizeHint() const {
+    return QSize(200, 40);
+}
+
+void SparklineWidget::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    rebuildPolyline();
+}
+
+void SparklineWidget::rebuildPolyline() {
+    m_polyline.clear();
+    
+    // Scale to the larger of the data and the guide so the guide stays visible
+    m_scaleMax = std::max(1.0, m_referenceValue);
+    for (double value : m_values) {
+        m_scaleMax = std::max(m_scaleMax, value);
+    }
+    m_scaleMax *= 1.1;
+    
+    if (m_values.size() < 2) {
+        return;
+    }
+    
+    // Newest point sits on the right edge; history scrolls left
+    double step = static_cast<double>(width() - 1) / (m_capacity - 1);
+    double h = height() - 2;
+    size_t start = m_values.size() > static_cast<size_t>(m_capacity) ? m_values.size() - m_capacity : 0;
+    size_t count = m_values.size() - start;
+    double x = (width() - 1) - step * (count - 1);
+    
+    m_polyline.reserve(static_cast<int>(count));
+    for (size_t i = start; i < m_values.size(); ++i) {
+        m_polyline << QPointF(x, 1 + h - (m_values[i] / m_scaleMax) * h);
+        x += step;
+    }
+}
+
+void SparklineWidget::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), QColor(30, 30, 30));
+    
+    if (m_referenceValue > 0.0) {
+        double h = height() - 2;
+        double y = 1 + h - (m_referenceValue / m_scaleMax) * h;
+        QPen guide(QColor(120, 120, 120));
+        guide.setStyle(Qt::DashLine);
+        painter.setPen(guide);
+        painter.drawLine(QPointF(0, y), QPointF(width(), y));
+    }
+    
+    if (!m_polyline.isEmpty()) {
+        QPen pen(m_lineColor);
+        pen.setWidthF(1.5);
+        painter.setPen(pen);
+        painter.drawPolyline(m_polyline);
+    }
+}
@@ -0,0 +1,63 @@
+#include "ui/StatsModel.h"
+#include "core/Tracker.h"
+
+StatsModel::StatsModel(const Tracker* tracker, QObject* parent)
+    : QObject(parent)
+    , m_tracker(tracker)
+{
+    m_pollTimer = new QTimer(this);
+    m_pollTimer->setInterval(250);
+    connect(m_pollTimer, &QTimer::timeout, this, &StatsModel::refresh);
+    
+    // Nothing moves while stopped; the last poll catches the final totals
+    connect(m_tracker, &Tracker::started, this, [this]() {
+        m_pollTimer->start();
+    });
+    connect(m_tracker, &Tracker::stopped, this, [this]() {
+        m_pollTimer->stop();
+        refresh();
+    });
+}
+
+StatsModel::~StatsModel() {
+}
+
+void StatsModel::setInterval(int intervalMs) {
+    m_pollTimer->setInterval(qMax(1, intervalMs));
+}
+
+int StatsModel::getInterval() const {
+    return m_pollTimer->interval();
+}
+
+const StatsSnapshot& StatsModel::getSnapshot() const {
+    return m_snapshot;
+}
+
+int StatsModel::refresh() {
+    StatsSnapshot next;
+    next.fps = static_cast<int>(m_tracker->getCurrentFPS());
+    next.targets = m_tracker->getTotalTargetsDetected();
+    next.assists = m_tracker->getTotalAssists();
+    next.runTimeSeconds = m_tracker->getRunningTimeMs() / 1000;
+    
+    int changed = 0;
+    if (next.fps != m_snapshot.fps) {
+        changed |= FPS;
+    }
+    if (next.targets != m_snapshot.targets) {
+        changed |= Targets;
+    }
+    if (next.assists != m_snapshot.assists) {
+        changed |= Assists;
+    }
+    if (next.runTimeSeconds != m_snapshot.runTimeSeconds) {
+        changed |= RunTime;
+    }
+    
+    if (changed != 0) {
+        m_snapshot = next;
+        emit updated(m_snapshot, changed);
+    }
+    return changed;
+}
@@ -1,20 +1,69 @@
 #include "utils/ConfigManager.h"
 #include <QFile>
+#include <QJsonArray>
+#include <QSaveFile>
 #include <QDir>
+#include <QFileInfo>
 #include <QJsonDocument>
 #include <QStandardPaths>
 #include <QCryptographicHash>
+#include <algorithm>
+
+namespace {
+// Slider drags produce a change per step; write once they settle
+const int kSaveDebounceMs = 500;
+
+// Editors and scripts often write a file in several steps
+const int kReloadDebounceMs = 100;
+}
 
 ConfigManager::ConfigManager(QObject* parent)
     : QObject(parent)
     , m_encryptionEnabled(false)
     , m_encryptionKey("AGA_DEFAULT_KEY_2024")
+    , m_dirty(false)
+    , m_ioContext(new QObject())
+    , m_saveGeneration(0)
+    , m_lastSaveOk(true)
+    , m_hotReloadEnabled(true)
 {
     m_configPath = getConfigFilePath();
     setDefaults();
+    
+    m_saveTimer = new QTimer(this);
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(kSaveDebounceMs);
+    connect(m_saveTimer, &QTimer::timeout, this, &ConfigManager::queueWrite);
+    
+    m_ioThread.setObjectName("ConfigWriter");
+    m_ioContext->moveToThread(&m_ioThread);
+    m_ioThread.start(QThread::LowPriority);
+    
+    m_reloadTimer = new QTimer(this);
+    m_reloadTimer->setSingleShot(true);
+    m_reloadTimer->setInterval(kReloadDebounceMs);
+    connect(m_reloadTimer, &QTimer::timeout, this, &ConfigManager::queueReload);
+    
+    // Atomic replaces (ours and most editors') swap the file out from under
+    // the watch, so the directory is watched too and the file re-added
+    m_watcher = new QFileSystemWatcher(this);
+    auto onChange = [this]() {
+        updateWatchedPaths();
+        if (m_hotReloadEnabled) {
+            m_reloadTimer->start();
+        }
+    };
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, onChange);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, onChange);
+    updateWatchedPaths();
 }
 
 ConfigManager::~ConfigManager() {
+    flush();
+    
+    m_ioThread.quit();
+    m_ioThread.wait();
+    delete m_ioContext;
 }
 
 QString ConfigManager::getConfigFilePath() const {
@@ -32,14 +81,28 @@ void ConfigManager::setDefaults() {
     m_config["fovRadius"] = 150;
     m_config["targetColor"] = "#FF0000";
     m_config["colorTolerance"] = 30;
+    m_config["calibratedRange"] = QJsonArray();
+    m_config["hueSatModel"] = QJsonObject();
+    m_config["backProjection"] = false;
+    m_config["adaptiveFPS"] = true;
+    m_config["latencyBudgetMs"] = 6.0;
+    m_config["maxFrameAgeMs"] = 0;
     m_config["overlayEnabled"] = true;
     m_config["fovCircleVisible"] = true;
     m_config["crosshairVisible"] = false;
+    m_config["hudVisible"] = false;
+    m_config["overlayLayerCaching"] = true;
     m_config["language"] = "en";
     m_config["activeMonitor"] = 0;
     m_config["minimizeToTray"] = true;
     m_config["startMinimized"] = false;
     m_config["toggleHotkey"] = "F6";
+    m_config["profileHotkey"] = "Ctrl+Shift+P";
+    m_config["profiles"] = QJsonObject();
+    m_config["activeProfile"] = "";
+    m_config["recordFrames"] = false;
+    m_config["metricsEndpoint"] = false;
+    m_config["metricsPort"] = 9464;
 }
 
 bool ConfigManager::load() {
@@ -72,25 +135,161 @@ bool ConfigManager::load() {
 }
 
 bool ConfigManager::save() {
-    QJsonDocument doc(m_config);
-    QByteArray data = doc.toJson(QJsonDocument::Indented);
+    queueWrite();
+    return true;
+}
+
+void ConfigManager::scheduleSave() {
+    if (m_dirty) {
+        m_saveTimer->start();
+    }
+}
+
+bool ConfigManager::flush() {
+    if (m_dirty || m_saveTimer->isActive()) {
+        queueWrite();
+    }
     
-    if (m_encryptionEnabled) {
+    // Queued writes run in order; this returns once all of them have
+    QMetaObject::invokeMethod(m_ioContext, []() {}, Qt::BlockingQueuedConnection);
+    return m_lastSaveOk.load();
+}
+
+void ConfigManager::queueWrite() {
+    m_saveTimer->stop();
+    m_dirty = false;
+    
+    // QJsonObject is implicitly shared: this copy is free, and the next
+    // setValue() detaches the GUI side instead of touching the I/O thread's
+    quint64 generation = ++m_saveGeneration;
+    QJsonObject config = m_config;
+    bool encrypted = m_encryptionEnabled;
+    
+    QMetaObject::invokeMethod(m_ioContext, [this, config, encrypted, generation]() {
+        // A newer snapshot is already queued behind this one
+        if (generation != m_saveGeneration.load()) {
+            return;
+        }
+        
+        QString error;
+        bool ok = writeConfig(config, encrypted, error);
+        m_lastSaveOk = ok;
+        
+        QMetaObject::invokeMethod(this, [this, ok, error]() {
+            if (ok) {
+                emit configSaved();
+            } else {
+                emit saveFailed(error);
+            }
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+bool ConfigManager::writeConfig(const QJsonObject& config, bool encrypted, QString& error) {
+    QByteArray data = QJsonDocument(config).toJson(QJsonDocument::Indented);
+    
+    if (encrypted) {
         data = encrypt(QString::fromUtf8(data)).toUtf8();
     }
     
-    QFile file(m_configPath);
+    // QSaveFile writes a temp file and renames it over config.json on commit,
+    // so a crash mid-write leaves the previous config intact
+    QSaveFile file(m_configPath);
     if (!file.open(QIODevice::WriteOnly)) {
+        error = file.errorString();
         return false;
     }
     
     file.write(data);
-    file.close();
+    if (!file.commit()) {
+        error = file.errorString();
+        return false;
+    }
     
-    emit configSaved();
+    // Lets the watcher tell our own writes from external edits
+    m_lastWrittenHash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
     return true;
 }
 
+void ConfigManager::setHotReloadEnabled(bool enabled) {
+    m_hotReloadEnabled = enabled;
+    if (!enabled) {
+        m_reloadTimer->stop();
+    }
+}
+
+bool ConfigManager::isHotReloadEnabled() const {
+    return m_hotReloadEnabled;
+}
+
+void ConfigManager::updateWatchedPaths() {
+    QString directory = QFileInfo(m_configPath).absolutePath();
+    if (!m_watcher->directories().contains(directory)) {
+        m_watcher->addPath(directory);
+    }
+    if (QFile::exists(m_configPath) && !m_watcher->files().contains(m_configPath)) {
+        m_watcher->addPath(m_configPath);
+    }
+}
+
+void ConfigManager::queueReload() {
+    bool encrypted = m_encryptionEnabled;
+    
+    // Read and parse next to the writes, so a reload never sees a file we
+    // are halfway through replacing and never blocks the GUI
+    QMetaObject::invokeMethod(m_ioContext, [this, encrypted]() {
+        QFile file(m_configPath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+        QByteArray data = file.readAll();
+        file.close();
+        
+        if (QCryptographicHash::hash(data, QCryptographicHash::Sha1) == m_lastWrittenHash) {
+            return;
+        }
+        
+        if (encrypted) {
+            data = decrypt(QString::fromUtf8(data)).toUtf8();
+        }
+        
+        // A half-written file from a non-atomic writer fails to parse; the
+        // watcher fires again when it's complete
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+            return;
+        }
+        
+        QJsonObject config = doc.object();
+        QMetaObject::invokeMethod(this, [this, config]() {
+            applyReloadedConfig(config);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+QStringList ConfigManager::applyChangedKeys(const QJsonObject& values) {
+    QStringList changedKeys;
+    
+    // Keys missing from values keep their current value
+    for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+        if (m_config.value(it.key()) == it.value()) {
+            continue;
+        }
+        m_config[it.key()] = it.value();
+        changedKeys.append(it.key());
+        emit settingChanged(it.key(), it.value().toVariant());
+    }
+    return changedKeys;
+}
+
+void ConfigManager::applyReloadedConfig(const QJsonObject& config) {
+    QStringList changedKeys = applyChangedKeys(config);
+    if (!changedKeys.isEmpty()) {
+        emit configReloaded(changedKeys);
+    }
+}
+
 void ConfigManager::reset() {
     setDefaults();
     save();
@@ -104,7 +303,13 @@ QVariant ConfigManager::getValue(const QString& key, const QVariant& defaultValu
 }
 
 void ConfigManager::setValue(const QString& key, const QVariant& value) {
-    m_config[key] = QJsonValue::fromVariant(value);
+    QJsonValue jsonValue = QJsonValue::fromVariant(value);
+    if (m_config.value(key) == jsonValue) {
+        return;
+    }
+    
+    m_config[key] = jsonValue;
+    m_dirty = true;
     emit settingChanged(key, value);
 }
 
@@ -149,6 +354,109 @@ void ConfigManager::setColorTolerance(int value) {
     setValue("colorTolerance", value);
 }
 
+CalibratedColorRange ConfigManager::getCalibratedRange() const {
+    return parseCalibratedRange(m_config["calibratedRange"]);
+}
+
+void ConfigManager::setCalibratedRange(const CalibratedColorRange& range) {
+    QVariantList values;
+    if (range.valid) {
+        for (int value : range.lower) {
+            values.append(value);
+        }
+        for (int value : range.upper) {
+            values.append(value);
+        }
+    }
+    setValue("calibratedRange", values);
+}
+
+CalibratedColorRange ConfigManager::parseCalibratedRange(const QJsonValue& value) {
+    CalibratedColorRange range;
+    QJsonArray values = value.toArray();
+    if (values.size() != 6) {
+        return range;
+    }
+    
+    static const int limits[3] = {179, 255, 255};
+    for (int i = 0; i < 3; ++i) {
+        range.lower[i] = std::clamp(values[i].toInt(), 0, limits[i]);
+        range.upper[i] = std::clamp(values[i + 3].toInt(), 0, limits[i]);
+    }
+    range.valid = true;
+    return range;
+}
+
+std::shared_ptr<const HueSatModel> ConfigManager::getHueSatModel() const {
+    return parseHueSatModel(m_config["hueSatModel"]);
+}
+
+void ConfigManager::setHueSatModel(const std::shared_ptr<const HueSatModel>& model) {
+    QVariantMap values;
+    if (model) {
+        // One bit per cell
+        QByteArray bits(static_cast<int>(model->cells.size() + 7) / 8, '\0');
+        char* data = bits.data();
+        for (size_t cell = 0; cell < model->cells.size(); ++cell) {
+            if (model->cells[cell]) {
+                data[cell / 8] |= static_cast<char>(1 << (cell % 8));
+            }
+        }
+        values["cells"] = QString::fromLatin1(bits.toBase64());
+        values["value"] = QVariantList{model->minValue, model->maxValue};
+    }
+    setValue("hueSatModel", values);
+}
+
+std::shared_ptr<const HueSatModel> ConfigManager::parseHueSatModel(const QJsonValue& value) {
+    QJsonObject object = value.toObject();
+    QByteArray bits = QByteArray::fromBase64(object.value("cells").toString().toLatin1());
+    QJsonArray valueRange = object.value("value").toArray();
+    
+    auto model = std::make_shared<HueSatModel>();
+    if (static_cast<size_t>(bits.size()) != (model->cells.size() + 7) / 8 || valueRange.size() != 2) {
+        return nullptr;
+    }
+    
+    for (size_t cell = 0; cell < model->cells.size(); ++cell) {
+        model->cells[cell] = (bits[static_cast<int>(cell / 8)] >> (cell % 8)) & 1 ? 255 : 0;
+    }
+    model->setValueRange(std::clamp(valueRange[0].toInt(), 0, 255), std::clamp(valueRange[1].toInt(), 0, 255));
+    return model;
+}
+
+bool ConfigManager::isBackProjectionEnabled() const {
+    return m_config["backProjection"].toBool(false);
+}
+
+void ConfigManager::setBackProjectionEnabled(bool enabled) {
+    setValue("backProjection", enabled);
+}
+
+bool ConfigManager::isAdaptiveFPSEnabled() const {
+    return m_config["adaptiveFPS"].toBool(true);
+}
+
+void ConfigManager::setAdaptiveFPSEnabled(bool enabled) {
+    setValue("adaptiveFPS", enabled);
+}
+
+double ConfigManager::getLatencyBudget() const {
+    return m_config["latencyBudgetMs"].toDouble(6.0);
+}
+
+void ConfigManager::setLatencyBudget(double budgetMs) {
+    setValue("latencyBudgetMs", budgetMs);
+}
+
+int ConfigManager::getMaxFrameAge() const {
+    return m_config["maxFrameAgeMs"].toInt(0);
+}
+
+void ConfigManager::setMaxFrameAge(int ageMs) {
+    setValue("maxFrameAgeMs", ageMs);
+}
+
 bool ConfigManager::isOverlayEnabled() const {
     return m_config["overlayEnabled"].toBool(true);
 }
@@ -173,6 +481,22 @@ void ConfigManager::setCrosshairVisible(bool visible) {
     setValue("crosshairVisible", visible);
 }
 
+bool ConfigManager::isHUDVisible() const {
+    return m_config["hudVisible"].toBool(false);
+}
+
+void ConfigManager::setHUDVisible(bool visible) {
+    setValue("hudVisible", visible);
+}
+
+bool ConfigManager::isOverlayLayerCachingEnabled() const {
+    return m_config["overlayLayerCaching"].toBool(true);
+}
+
+void ConfigManager::setOverlayLayerCachingEnabled(bool enabled) {
+    setValue("overlayLayerCaching", enabled);
+}
+
 QString ConfigManager::getLanguage() const {
     return m_config["language"].toString("en");
 }
@@ -205,6 +529,30 @@ void ConfigManager::setStartMinimized(bool minimized) {
     setValue("startMinimized", minimized);
 }
 
+bool ConfigManager::isRecordingEnabled() const {
+    return m_config["recordFrames"].toBool(false);
+}
+
+void ConfigManager::setRecordingEnabled(bool enabled) {
+    setValue("recordFrames", enabled);
+}
+
+bool ConfigManager::isMetricsEndpointEnabled() const {
+    return m_config["metricsEndpoint"].toBool(false);
+}
+
+void ConfigManager::setMetricsEndpointEnabled(bool enabled) {
+    setValue("metricsEndpoint", enabled);
+}
+
+int ConfigManager::getMetricsPort() const {
+    return m_config["metricsPort"].toInt(9464);
+}
+
+void ConfigManager::setMetricsPort(int port) {
+    setValue("metricsPort", std::clamp(port, 1024, 65535));
+}
+
 QString ConfigManager::getToggleHotkey() const {
     return m_config["toggleHotkey"].toString("F6");
 }
@@ -213,6 +561,81 @@ void ConfigManager::setToggleHotkey(const QString& hotkey) {
     setValue("toggleHotkey", hotkey);
 }
 
+QString ConfigManager::getProfileHotkey() const {
+    return m_config["profileHotkey"].toString("Ctrl+Shift+P");
+}
+
+void ConfigManager::setProfileHotkey(const QString& hotkey) {
+    setValue("profileHotkey", hotkey);
+}
+
+const QStringList& ConfigManager::getProfileKeys() {
+    // Everything that is tuned per game: detection, colour range, assist,
+    // frame pacing and the capture region (monitor + FOV)
+    static const QStringList keys = {
+        "aimAssistStrength", "responseSpeed", "fovRadius", "targetColor", "colorTolerance",
+        "calibratedRange", "hueSatModel", "backProjection", "adaptiveFPS", "latencyBudgetMs",
+        "maxFrameAgeMs", "activeMonitor", "fovCircleVisible", "crosshairVisible"
+    };
+    return keys;
+}
+
+QStringList ConfigManager::getProfileNames() const {
+    QStringList names = m_config["profiles"].toObject().keys();
+    names.sort(Qt::CaseInsensitive);
+    return names;
+}
+
+QJsonObject ConfigManager::getProfile(const QString& name) const {
+    return m_config["profiles"].toObject().value(name).toObject();
+}
+
+QString ConfigManager::getActiveProfile() const {
+    return m_config["activeProfile"].toString();
+}
+
+void ConfigManager::saveProfile(const QString& name) {
+    QJsonObject profile;
+    for (const QString& key : getProfileKeys()) {
+        if (m_config.contains(key)) {
+            profile[key] = m_config[key];
+        }
+    }
+    
+    QJsonObject profiles = m_config["profiles"].toObject();
+    profiles[name] = profile;
+    setValue("profiles", profiles);
+    setValue("activeProfile", name);
+}
+
+bool ConfigManager::applyProfile(const QString& name) {
+    QJsonObject profiles = m_config["profiles"].toObject();
+    if (!profiles.contains(name)) {
+        return false;
+    }
+    
+    // Same incremental path as a hot reload: only differing keys change
+    QStringList changedKeys = applyChangedKeys(profiles[name].toObject());
+    
+    m_config["activeProfile"] = name;
+    m_dirty = true;
+    
+    if (!changedKeys.isEmpty()) {
+        emit configReloaded(changedKeys);
+    }
+    return true;
+}
+
+void ConfigManager::deleteProfile(const QString& name) {
+    QJsonObject profiles = m_config["profiles"].toObject();
+    profiles.remove(name);
+    setValue("profiles", profiles);
+    
+    if (getActiveProfile() == name) {
+        setValue("activeProfile", QString());
+    }
+}
+
 void ConfigManager::setEncryptionEnabled(bool enabled) {
     m_encryptionEnabled = enabled;
 }
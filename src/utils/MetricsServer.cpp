@@ -0,0 +1,137 @@
+#include "utils/MetricsServer.h"
+#include "core/MetricsRegistry.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QTimer>
+
+namespace {
+// Requests larger than this, or slower than the timeout, are dropped
+const int kMaxRequestBytes = 8192;
+const int kRequestTimeoutMs = 5000;
+
+QByteArray httpResponse(const QByteArray& status, const QByteArray& contentType, const QByteArray& body) {
+    return "HTTP/1.1 " + status + "\r\n"
+           "Content-Type: " + contentType + "\r\n"
+           "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+           "Connection: close\r\n"
+           "\r\n" + body;
+}
+}
+
+MetricsServer::MetricsServer(MetricsRegistry* registry, QObject* parent)
+    : QObject(parent)
+    , m_registry(registry)
+    , m_context(nullptr)
+    , m_server(nullptr)
+    , m_port(0)
+{
+    m_thread.setObjectName("MetricsServer");
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start(quint16 port) {
+    if (isRunning()) {
+        return true;
+    }
+    
+    m_context = new QObject();
+    m_context->moveToThread(&m_thread);
+    m_thread.start(QThread::LowPriority);
+    
+    // The server is created and listens on its own thread; the caller waits
+    // only for the listen result
+    bool listening = false;
+    QMetaObject::invokeMethod(m_context, [this, port, &listening]() {
+        m_server = new QTcpServer(m_context);
+        connect(m_server, &QTcpServer::newConnection, m_server, [this]() { handleConnection(); });
+        
+        listening = m_server->listen(QHostAddress::LocalHost, port);
+        if (!listening) {
+            m_errorString = m_server->errorString();
+            delete m_server;
+            m_server = nullptr;
+        }
+    }, Qt::BlockingQueuedConnection);
+    
+    if (!listening) {
+        m_thread.quit();
+        m_thread.wait();
+        delete m_context;
+        m_context = nullptr;
+        emit serverError(QString("Metrics endpoint failed to listen on port %1: %2").arg(port).arg(m_errorString));
+        return false;
+    }
+    
+    m_port = port;
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!m_thread.isRunning()) {
+        return;
+    }
+    
+    // Sockets must be torn down on the thread that owns them
+    QMetaObject::invokeMethod(m_context, [this]() {
+        delete m_server;
+        m_server = nullptr;
+    }, Qt::BlockingQueuedConnection);
+    
+    m_thread.quit();
+    m_thread.wait();
+    delete m_context;
+    m_context = nullptr;
+    m_port = 0;
+}
+
+bool MetricsServer::isRunning() const {
+    return m_thread.isRunning() && m_port != 0;
+}
+
+quint16 MetricsServer::getPort() const {
+    return m_port;
+}
+
+QString MetricsServer::getErrorString() const {
+    return m_errorString;
+}
+
+void MetricsServer::handleConnection() {
+    // Runs on the server thread
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        QTimer::singleShot(kRequestTimeoutMs, socket, [socket]() { socket->abort(); });
+        
+        connect(socket, &QTcpSocket::readyRead, socket, [this, socket]() {
+            if (socket->bytesAvailable() > kMaxRequestBytes) {
+                socket->abort();
+                return;
+            }
+            if (!socket->canReadLine()) {
+                return;
+            }
+            
+            // Only the request line matters; headers are ignored
+            QList<QByteArray> request = socket->readLine().trimmed().split(' ');
+            QByteArray method = request.value(0);
+            QByteArray path = request.value(1);
+            
+            QByteArray response;
+            if (method != "GET") {
+                response = httpResponse("405 Method Not Allowed", "text/plain", "GET only\n");
+            } else if (path == "/metrics") {
+                response = httpResponse("200 OK", "text/plain; version=0.0.4; charset=utf-8",
+                                        m_registry->renderPrometheus());
+            } else {
+                response = httpResponse("404 Not Found", "text/plain", "Try /metrics\n");
+            }
+            
+            socket->write(response);
+            socket->disconnectFromHost();
+        });
+    }
+}
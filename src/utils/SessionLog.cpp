@@ -0,0 +1,315 @@
+#include "utils/SessionLog.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDateTime>
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace {
+const char kLogMagic[8] = {'A', 'G', 'A', 'S', 'L', 'O', 'G', '1'};
+const quint32 kLogVersion = 1;
+const qint64 kFileHeaderSize = sizeof(kLogMagic) + sizeof(quint32);
+const quint32 kRecordMagic = 0x43455253; // 'SREC'
+
+#pragma pack(push, 1)
+struct RecordHeader {
+    quint32 magic;
+    quint16 type;
+    quint16 reserved;
+    quint32 payloadSize;
+    quint32 checksum;       // CRC-32 of the header (checksum = 0) and payload
+    qint64 timestampMs;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(RecordHeader) == 24, "RecordHeader layout is part of the file format");
+
+const std::array<quint32, 256>& crcTable() {
+    static const std::array<quint32, 256> table = [] {
+        std::array<quint32, 256> t{};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+quint32 crc32Update(quint32 crc, const char* data, qint64 size) {
+    const auto& table = crcTable();
+    crc = ~crc;
+    for (qint64 i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<quint8>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+quint32 recordChecksum(RecordHeader header, const QByteArray& payload) {
+    header.checksum = 0;
+    quint32 crc = crc32Update(0, reinterpret_cast<const char*>(&header), sizeof(header));
+    return crc32Update(crc, payload.constData(), payload.size());
+}
+}
+
+SessionLog::SessionLog(const QString& filePath)
+    : m_filePath(filePath)
+{
+}
+
+SessionLog::~SessionLog() {
+    close();
+}
+
+bool SessionLog::open() {
+    close();
+    
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    
+    m_file.setFileName(m_filePath);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        m_errorString = m_file.errorString();
+        return false;
+    }
+    
+    if (m_file.size() == 0) {
+        m_file.write(kLogMagic, sizeof(kLogMagic));
+        m_file.write(reinterpret_cast<const char*>(&kLogVersion), sizeof(kLogVersion));
+        m_file.flush();
+    }
+    
+    if (!scan()) {
+        m_file.close();
+        return false;
+    }
+    
+    return true;
+}
+
+void SessionLog::close() {
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_index.clear();
+}
+
+bool SessionLog::isOpen() const {
+    return m_file.isOpen();
+}
+
+bool SessionLog::scan() {
+    m_index.clear();
+    
+    char magic[sizeof(kLogMagic)];
+    quint32 version = 0;
+    m_file.seek(0);
+    if (m_file.read(magic, sizeof(magic)) != sizeof(magic) ||
+        std::memcmp(magic, kLogMagic, sizeof(kLogMagic)) != 0 ||
+        m_file.read(reinterpret_cast<char*>(&version), sizeof(version)) != sizeof(version) ||
+        version != kLogVersion) {
+        m_errorString = "Not a session log";
+        return false;
+    }
+    
+    // Headers only: payloads are skipped, so this is one small read per record
+    qint64 fileSize = m_file.size();
+    qint64 offset = kFileHeaderSize;
+    while (offset + static_cast<qint64>(sizeof(RecordHeader)) <= fileSize) {
+        RecordHeader header;
+        m_file.seek(offset);
+        if (m_file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) ||
+            header.magic != kRecordMagic) {
+            break;
+        }
+        
+        qint64 payloadOffset = offset + static_cast<qint64>(sizeof(header));
+        if (payloadOffset + header.payloadSize > fileSize) {
+            break;
+        }
+        
+        m_index.push_back({header.timestampMs, payloadOffset, header.payloadSize, header.checksum,
+                           static_cast<RecordType>(header.type)});
+        offset = payloadOffset + header.payloadSize;
+    }
+    
+    // A crash can only tear the last record; verify it fully and drop it if bad
+    if (!m_index.empty()) {
+        QByteArray payload;
+        if (!readPayload(m_index.back(), payload)) {
+            offset = m_index.back().offset - static_cast<qint64>(sizeof(RecordHeader));
+            m_index.pop_back();
+        }
+    }
+    
+    if (offset < fileSize) {
+        m_file.resize(offset);
+    }
+    
+    return true;
+}
+
+bool SessionLog::append(RecordType type, qint64 timestampMs, const QByteArray& payload) {
+    if (!m_file.isOpen()) {
+        m_errorString = "Session log is not open";
+        return false;
+    }
+    
+    RecordHeader header;
+    header.magic = kRecordMagic;
+    header.type = static_cast<quint16>(type);
+    header.reserved = 0;
+    header.payloadSize = static_cast<quint32>(payload.size());
+    header.checksum = 0;
+    header.timestampMs = timestampMs;
+    header.checksum = recordChecksum(header, payload);
+    
+    qint64 offset = m_file.size();
+    m_file.seek(offset);
+    
+    if (m_file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header) ||
+        m_file.write(payload) != payload.size() ||
+        !m_file.flush()) {
+        m_errorString = m_file.errorString();
+        m_file.resize(offset);
+        return false;
+    }
+    
+    m_index.push_back({timestampMs, offset + static_cast<qint64>(sizeof(header)),
+                       header.payloadSize, header.checksum, type});
+    return true;
+}
+
+bool SessionLog::readPayload(const IndexEntry& entry, QByteArray& payload) const {
+    if (!m_file.seek(entry.offset)) {
+        return false;
+    }
+    
+    payload = m_file.read(entry.payloadSize);
+    if (payload.size() != static_cast<int>(entry.payloadSize)) {
+        return false;
+    }
+    
+    RecordHeader header;
+    header.magic = kRecordMagic;
+    header.type = static_cast<quint16>(entry.type);
+    header.reserved = 0;
+    header.payloadSize = entry.payloadSize;
+    header.checksum = 0;
+    header.timestampMs = entry.timestampMs;
+    return recordChecksum(header, payload) == entry.checksum;
+}
+
+std::vector<SessionLog::Record> SessionLog::query(RecordType type, qint64 fromMs, qint64 toMs) const {
+    std::vector<Record> records;
+    
+    // Append order is time order, so the range start is a binary search
+    auto begin = std::lower_bound(m_index.begin(), m_index.end(), fromMs,
+        [](const IndexEntry& entry, qint64 value) {
+            return entry.timestampMs < value;
+        });
+    
+    for (auto it = begin; it != m_index.end() && it->timestampMs < toMs; ++it) {
+        if (it->type != type) {
+            continue;
+        }
+        
+        Record record{type, it->timestampMs, QByteArray()};
+        if (readPayload(*it, record.payload)) {
+            records.push_back(std::move(record));
+        }
+    }
+    
+    return records;
+}
+
+bool SessionLog::readLatest(RecordType type, Record& record) const {
+    for (auto it = m_index.rbegin(); it != m_index.rend(); ++it) {
+        if (it->type == type && readPayload(*it, record.payload)) {
+            record.type = type;
+            record.timestampMs = it->timestampMs;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SessionLog::compact(qint64 rollupRetentionMs) {
+    if (!m_file.isOpen()) {
+        return false;
+    }
+    
+    qint64 rollupCutoff = QDateTime::currentMSecsSinceEpoch() - rollupRetentionMs;
+    
+    // Index of the newest totals record; older ones are superseded
+    int latestTotals = -1;
+    for (int i = static_cast<int>(m_index.size()) - 1; i >= 0; --i) {
+        if (m_index[i].type == RecordType::Totals) {
+            latestTotals = i;
+            break;
+        }
+    }
+    
+    QSaveFile out(m_filePath);
+    if (!out.open(QIODevice::WriteOnly)) {
+        m_errorString = out.errorString();
+        return false;
+    }
+    
+    out.write(kLogMagic, sizeof(kLogMagic));
+    out.write(reinterpret_cast<const char*>(&kLogVersion), sizeof(kLogVersion));
+    
+    for (int i = 0; i < static_cast<int>(m_index.size()); ++i) {
+        const IndexEntry& entry = m_index[i];
+        
+        bool keep = entry.type == RecordType::Session ||
+                    (entry.type == RecordType::Totals && i == latestTotals) ||
+                    ((entry.type == RecordType::Rollups || entry.type == RecordType::Resources) &&
+                     entry.timestampMs >= rollupCutoff);
+        
+        QByteArray payload;
+        if (!keep || !readPayload(entry, payload)) {
+            continue;
+        }
+        
+        RecordHeader header;
+        header.magic = kRecordMagic;
+        header.type = static_cast<quint16>(entry.type);
+        header.reserved = 0;
+        header.payloadSize = entry.payloadSize;
+        header.checksum = entry.checksum;
+        header.timestampMs = entry.timestampMs;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(payload);
+    }
+    
+    // Swap the compacted file in atomically, then re-index it
+    m_file.close();
+    if (!out.commit()) {
+        m_errorString = out.errorString();
+        open();
+        return false;
+    }
+    
+    return open();
+}
+
+qint64 SessionLog::getFileSize() const {
+    return m_file.isOpen() ? m_file.size() : 0;
+}
+
+int SessionLog::getRecordCount() const {
+    return static_cast<int>(m_index.size());
+}
+
+QString SessionLog::getFilePath() const {
+    return m_filePath;
+}
+
+QString SessionLog::getErrorString() const {
+    return m_errorString;
+}
@@ -3,6 +3,27 @@
 #include <QDir>
 #include <QJsonDocument>
 #include <QStandardPaths>
+#include <QDataStream>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+const char kRollupMagic[8] = {'A', 'G', 'A', 'R', 'O', 'L', 'L', '1'};
+const quint32 kRollupVersion = 2;
+
+// Rollups are written in batches so the log sees one record per minute
+const int kRollupsPerRecord = 60;
+
+// Compact at startup once the log grows past this
+const qint64 kCompactThresholdBytes = 8 * 1024 * 1024;
+const qint64 kRollupRetentionMs = 30LL * 24 * 3600 * 1000;
+
+static_assert(sizeof(MetricsRollup) == 16 * 4, "MetricsRollup must stay unpadded");
+
+quint32 clampDelta(quint64 current, quint64 previous) {
+    return current > previous ? static_cast<quint32>(std::min<quint64>(current - previous, 0xFFFFFFFFu)) : 0;
+}
+}
 
 StatsTracker::StatsTracker(QObject* parent)
     : QObject(parent)
@@ -12,6 +33,17 @@ StatsTracker::StatsTracker(QObject* parent)
     , m_sessionFPSSum(0.0)
     , m_sessionFPSCount(0)
     , m_sessionPeakFPS(0)
+    , m_sessionStartMs(0)
+    , m_rollupCapacity(6 * 3600)
+    , m_rollupNext(0)
+    , m_rollupCount(0)
+    , m_lastTotalTargets(0)
+    , m_lastTotalDrops(0)
+    , m_lastCpuTimeUs(0)
+    , m_lastVoluntarySwitches(0)
+    , m_lastInvoluntarySwitches(0)
+    , m_lastPageFaults(0)
+    , m_sessionLog(std::make_unique<SessionLog>(getStatsFilePath()))
     , m_totalTargets(0)
     , m_totalAssists(0)
     , m_totalRuntime(0)
@@ -21,10 +53,12 @@ StatsTracker::StatsTracker(QObject* parent)
 }
 
 StatsTracker::~StatsTracker() {
+    // endSession() already appends the final totals
     if (m_sessionActive) {
         endSession();
+    } else {
+        saveStats();
     }
-    saveStats();
 }
 
 void StatsTracker::startSession() {
@@ -38,6 +72,17 @@ void StatsTracker::startSession() {
     m_sessionFPSSum = 0.0;
     m_sessionFPSCount = 0;
     m_sessionPeakFPS = 0;
+    m_sessionStartMs = QDateTime::currentMSecsSinceEpoch();
+    m_pendingRollups.clear();
+    m_pendingRollups.reserve(kRollupsPerRecord);
+    
+    // The ring is sized once per session; appends never allocate
+    m_rollups.assign(m_rollupCapacity, MetricsRollup{});
+    m_rollupNext = 0;
+    m_rollupCount = 0;
+    m_lastTotalTargets = -1;
+    m_lastTotalDrops = -1;
+    resetResourceBaseline();
     
     m_sessionTimer.start();
     
@@ -59,13 +104,24 @@ void StatsTracker::endSession() {
     
     // Create session stats
     SessionStats stats;
-    stats.startTime = 0; // Would need to track actual start time
-    stats.endTime = 0;
+    stats.startTime = m_sessionStartMs;
+    stats.endTime = QDateTime::currentMSecsSinceEpoch();
     stats.targetsDetected = m_sessionTargets;
     stats.assistsApplied = m_sessionAssists;
     stats.avgFPS = getSessionAvgFPS();
     stats.peakFPS = m_sessionPeakFPS;
     
+    flushRollups();
+    
+    if (m_sessionLog->isOpen()) {
+        QByteArray payload;
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream << stats.startTime << stats.endTime << qint32(stats.targetsDetected)
+               << qint32(stats.assistsApplied) << stats.avgFPS << qint32(stats.peakFPS);
+        m_sessionLog->append(SessionLog::RecordType::Session, stats.endTime, payload);
+    }
+    
     saveStats();
     
     emit sessionEnded(stats);
@@ -101,6 +157,254 @@ void StatsTracker::recordFPS(double fps) {
     }
 }
 
+void StatsTracker::recordPipelineStats(const PipelineStats& stats) {
+    if (!m_sessionActive || m_rollups.empty()) {
+        return;
+    }
+    
+    recordFPS(stats.fps);
+    
+    // Tracker counters are cumulative; the first sample only sets the baseline
+    int totalDrops = stats.staleFramesDropped + stats.staleDetectionsDropped;
+    if (m_lastTotalTargets < 0) {
+        m_lastTotalTargets = stats.totalTargets;
+        m_lastTotalDrops = totalDrops;
+    }
+    
+    const ResourceSample& resources = m_resourceMonitor.sample();
+    quint64 pageFaults = resources.minorFaults + resources.majorFaults;
+    
+    MetricsRollup& rollup = m_rollups[m_rollupNext];
+    rollup.second = static_cast<quint32>(m_sessionTimer.elapsed() / 1000);
+    rollup.fps = static_cast<float>(stats.fps);
+    rollup.captureP50Ms = static_cast<float>(stats.captureLatency.p50);
+    rollup.captureP95Ms = static_cast<float>(stats.captureLatency.p95);
+    rollup.detectP50Ms = static_cast<float>(stats.detectLatency.p50);
+    rollup.detectP95Ms = static_cast<float>(stats.detectLatency.p95);
+    rollup.frameP50Ms = static_cast<float>(stats.frameLatency.p50);
+    rollup.frameP95Ms = static_cast<float>(stats.frameLatency.p95);
+    rollup.frameP99Ms = static_cast<float>(stats.frameLatency.p99);
+    rollup.targets = static_cast<quint32>(std::max(0, stats.totalTargets - m_lastTotalTargets));
+    rollup.drops = static_cast<quint32>(std::max(0, totalDrops - m_lastTotalDrops));
+    rollup.cpuTimeMs = static_cast<float>((resources.cpuTimeUs - m_lastCpuTimeUs) / 1000.0);
+    rollup.residentKb = static_cast<quint32>(std::min<quint64>(resources.residentBytes / 1024, 0xFFFFFFFFu));
+    rollup.voluntarySwitches = clampDelta(resources.voluntarySwitches, m_lastVoluntarySwitches);
+    rollup.involuntarySwitches = clampDelta(resources.involuntarySwitches, m_lastInvoluntarySwitches);
+    rollup.pageFaults = clampDelta(pageFaults, m_lastPageFaults);
+    
+    m_lastTotalTargets = stats.totalTargets;
+    m_lastTotalDrops = totalDrops;
+    m_lastCpuTimeUs = resources.cpuTimeUs;
+    m_lastVoluntarySwitches = resources.voluntarySwitches;
+    m_lastInvoluntarySwitches = resources.involuntarySwitches;
+    m_lastPageFaults = pageFaults;
+    
+    m_rollupNext = (m_rollupNext + 1) % m_rollupCapacity;
+    m_rollupCount = std::min(m_rollupCount + 1, m_rollupCapacity);
+    
+    m_pendingRollups.push_back(rollup);
+    if (static_cast<int>(m_pendingRollups.size()) >= kRollupsPerRecord) {
+        flushRollups();
+    }
+    
+    emit rollupRecorded(rollup);
+}
+
+void StatsTracker::setRollupCapacity(int seconds) {
+    // Takes effect at the next session so the live ring is never reallocated
+    m_rollupCapacity = std::clamp(seconds, 60, 24 * 3600);
+}
+
+int StatsTracker::getRollupCapacity() const {
+    return m_rollupCapacity;
+}
+
+int StatsTracker::getRollupCount() const {
+    return m_rollupCount;
+}
+
+const ResourceSample& StatsTracker::getLastResourceSample() const {
+    return m_resourceMonitor.getLastSample();
+}
+
+void StatsTracker::resetResourceBaseline() {
+    const ResourceSample& resources = m_resourceMonitor.sample();
+    m_lastCpuTimeUs = resources.cpuTimeUs;
+    m_lastVoluntarySwitches = resources.voluntarySwitches;
+    m_lastInvoluntarySwitches = resources.involuntarySwitches;
+    m_lastPageFaults = resources.minorFaults + resources.majorFaults;
+}
+
+std::vector<MetricsRollup> StatsTracker::getRecentRollups(int count) const {
+    std::vector<MetricsRollup> result;
+    count = std::clamp(count, 0, m_rollupCount);
+    result.reserve(count);
+    
+    int capacity = static_cast<int>(m_rollups.size());
+    for (int i = count; i > 0; --i) {
+        result.push_back(m_rollups[(m_rollupNext - i + capacity) % capacity]);
+    }
+    return result;
+}
+
+QByteArray StatsTracker::exportRollups() const {
+    std::vector<MetricsRollup> rollups = getRecentRollups(m_rollupCount);
+    
+    quint32 header[3] = {kRollupVersion, static_cast<quint32>(sizeof(MetricsRollup)),
+                         static_cast<quint32>(rollups.size())};
+    
+    QByteArray data;
+    data.reserve(static_cast<int>(sizeof(kRollupMagic) + sizeof(header) +
+                                  rollups.size() * sizeof(MetricsRollup)));
+    data.append(kRollupMagic, sizeof(kRollupMagic));
+    data.append(reinterpret_cast<const char*>(header), sizeof(header));
+    if (!rollups.empty()) {
+        data.append(reinterpret_cast<const char*>(rollups.data()),
+                    static_cast<int>(rollups.size() * sizeof(MetricsRollup)));
+    }
+    return data;
+}
+
+bool StatsTracker::exportRollups(const QString& filePath) const {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    
+    QByteArray data = exportRollups();
+    bool ok = file.write(data) == data.size();
+    file.close();
+    
+    return ok;
+}
+
+void StatsTracker::flushRollups() {
+    if (m_pendingRollups.empty() || !m_sessionLog->isOpen()) {
+        m_pendingRollups.clear();
+        return;
+    }
+    
+    // Session start and record size, then the records exactly as
+    // exportRollups() lays them out
+    const quint32 recordSize = sizeof(MetricsRollup);
+    QByteArray payload;
+    payload.reserve(static_cast<int>(sizeof(qint64) + sizeof(recordSize) +
+                                     m_pendingRollups.size() * sizeof(MetricsRollup)));
+    payload.append(reinterpret_cast<const char*>(&m_sessionStartMs), sizeof(m_sessionStartMs));
+    payload.append(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+    payload.append(reinterpret_cast<const char*>(m_pendingRollups.data()),
+                   static_cast<int>(m_pendingRollups.size() * sizeof(MetricsRollup)));
+    
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    m_sessionLog->append(SessionLog::RecordType::Rollups, now, payload);
+    m_pendingRollups.clear();
+    
+    // Per-thread usage doesn't fit a fixed-size rollup; keep one snapshot
+    // per batch instead
+    const ResourceSample& resources = m_resourceMonitor.getLastSample();
+    QByteArray snapshot;
+    QDataStream stream(&snapshot, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream << m_sessionStartMs << resources.timestampMs << resources.cpuTimeUs << resources.cpuPercent
+           << resources.residentBytes << resources.peakResidentBytes
+           << resources.voluntarySwitches << resources.involuntarySwitches
+           << resources.minorFaults << resources.majorFaults
+           << static_cast<quint32>(resources.threads.size());
+    for (const auto& thread : resources.threads) {
+        stream << thread.threadId << thread.name << thread.cpuTimeUs << thread.cpuPercent
+               << thread.voluntarySwitches << thread.involuntarySwitches;
+    }
+    
+    m_sessionLog->append(SessionLog::RecordType::Resources, now, snapshot);
+}
+
+std::vector<SessionStats> StatsTracker::getSessionHistory(qint64 fromMs, qint64 toMs) const {
+    std::vector<SessionStats> history;
+    
+    for (const auto& record : m_sessionLog->query(SessionLog::RecordType::Session, fromMs, toMs)) {
+        QDataStream stream(record.payload);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        
+        SessionStats stats;
+        qint32 targets = 0, assists = 0, peak = 0;
+        stream >> stats.startTime >> stats.endTime >> targets >> assists >> stats.avgFPS >> peak;
+        if (stream.status() != QDataStream::Ok) {
+            continue;
+        }
+        
+        stats.targetsDetected = targets;
+        stats.assistsApplied = assists;
+        stats.peakFPS = peak;
+        history.push_back(stats);
+    }
+    
+    return history;
+}
+
+std::vector<RollupBatch> StatsTracker::getRollupHistory(qint64 fromMs, qint64 toMs) const {
+    std::vector<RollupBatch> history;
+    
+    const size_t kHeaderSize = sizeof(qint64) + sizeof(quint32);
+    
+    for (const auto& record : m_sessionLog->query(SessionLog::RecordType::Rollups, fromMs, toMs)) {
+        const QByteArray& payload = record.payload;
+        if (payload.size() < static_cast<int>(kHeaderSize)) {
+            continue;
+        }
+        
+        RollupBatch batch;
+        quint32 recordSize = 0;
+        std::memcpy(&batch.sessionStartMs, payload.constData(), sizeof(qint64));
+        std::memcpy(&recordSize, payload.constData() + sizeof(qint64), sizeof(quint32));
+        if (recordSize == 0) {
+            continue;
+        }
+        
+        // Records written by an older layout are shorter; newer fields stay zero
+        const char* records = payload.constData() + kHeaderSize;
+        size_t count = (payload.size() - kHeaderSize) / recordSize;
+        size_t copySize = std::min<size_t>(recordSize, sizeof(MetricsRollup));
+        batch.rollups.assign(count, MetricsRollup{});
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(&batch.rollups[i], records + i * recordSize, copySize);
+        }
+        history.push_back(std::move(batch));
+    }
+    
+    return history;
+}
+
+std::vector<ResourceSample> StatsTracker::getResourceHistory(qint64 fromMs, qint64 toMs) const {
+    std::vector<ResourceSample> history;
+    
+    for (const auto& record : m_sessionLog->query(SessionLog::RecordType::Resources, fromMs, toMs)) {
+        QDataStream stream(record.payload);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        
+        ResourceSample sample;
+        qint64 sessionStartMs = 0;
+        quint32 threadCount = 0;
+        stream >> sessionStartMs >> sample.timestampMs >> sample.cpuTimeUs >> sample.cpuPercent
+               >> sample.residentBytes >> sample.peakResidentBytes
+               >> sample.voluntarySwitches >> sample.involuntarySwitches
+               >> sample.minorFaults >> sample.majorFaults >> threadCount;
+        
+        for (quint32 i = 0; i < threadCount && stream.status() == QDataStream::Ok; ++i) {
+            ThreadResourceSample thread;
+            stream >> thread.threadId >> thread.name >> thread.cpuTimeUs >> thread.cpuPercent
+                   >> thread.voluntarySwitches >> thread.involuntarySwitches;
+            sample.threads.push_back(std::move(thread));
+        }
+        
+        if (stream.status() != QDataStream::Ok) {
+            continue;
+        }
+        history.push_back(std::move(sample));
+    }
+    
+    return history;
+}
+
 int StatsTracker::getSessionTargets() const {
     return m_sessionTargets;
 }
@@ -185,11 +489,52 @@ QString StatsTracker::getStatsFilePath() const {
     if (!dir.exists()) {
         dir.mkpath(".");
     }
-    return appDataPath + "/stats.json";
+    return appDataPath + "/stats.log";
+}
+
+QString StatsTracker::getLegacyStatsFilePath() const {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/stats.json";
 }
 
 bool StatsTracker::loadStats() {
-    QFile file(getStatsFilePath());
+    if (!m_sessionLog->isOpen() && !m_sessionLog->open()) {
+        return loadLegacyStats();
+    }
+    
+    if (m_sessionLog->getFileSize() > kCompactThresholdBytes) {
+        m_sessionLog->compact(kRollupRetentionMs);
+    }
+    
+    // Lifetime totals are the newest totals record; nothing else is read
+    SessionLog::Record record;
+    if (!m_sessionLog->readLatest(SessionLog::RecordType::Totals, record)) {
+        // First run on the log: carry over totals from the old JSON file
+        if (loadLegacyStats()) {
+            saveStats();
+            return true;
+        }
+        return false;
+    }
+    
+    QDataStream stream(record.payload);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    qint32 targets = 0, assists = 0, sessions = 0;
+    qint64 runtime = 0;
+    stream >> targets >> assists >> runtime >> sessions;
+    if (stream.status() != QDataStream::Ok) {
+        return false;
+    }
+    
+    m_totalTargets = targets;
+    m_totalAssists = assists;
+    m_totalRuntime = runtime;
+    m_totalSessions = sessions;
+    
+    return true;
+}
+
+bool StatsTracker::loadLegacyStats() {
+    QFile file(getLegacyStatsFilePath());
     if (!file.exists()) {
         return false;
     }
@@ -218,23 +563,19 @@ bool StatsTracker::loadStats() {
 }
 
 bool StatsTracker::saveStats() {
-    QJsonObject obj;
-    obj["totalTargets"] = m_totalTargets;
-    obj["totalAssists"] = m_totalAssists;
-    obj["totalRuntime"] = static_cast<qint64>(m_totalRuntime);
-    obj["totalSessions"] = m_totalSessions;
-    
-    QJsonDocument doc(obj);
-    
-    QFile file(getStatsFilePath());
-    if (!file.open(QIODevice::WriteOnly)) {
+    if (!m_sessionLog->isOpen()) {
         return false;
     }
     
-    file.write(doc.toJson(QJsonDocument::Indented));
-    file.close();
+    // A new totals record supersedes the previous one; nothing is rewritten
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream << qint32(m_totalTargets) << qint32(m_totalAssists)
+           << static_cast<qint64>(m_totalRuntime) << qint32(m_totalSessions);
     
-    return true;
+    return m_sessionLog->append(SessionLog::RecordType::Totals,
+                                QDateTime::currentMSecsSinceEpoch(), payload);
 }
 
 void StatsTracker::resetStats() {